@@ -0,0 +1,72 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// 基准程序共用的小工具，不属于容器库本身。
+// 每个基准程序的第一个命令行参数是规模，ctest 以较小的规模运行它们，只检查结果是否正确
+namespace bench {
+
+class Timer {
+private:
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+public:
+    [[nodiscard]] double ms() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// 重复 repeat 次：先执行不计时的 prepare，再对 task 计时，返回最快的一次（毫秒）
+template<class Prepare, class Task>
+double best_ms(const int repeat, Prepare prepare, Task task) {
+    double best = 0;
+    for (int i = 0; i < repeat; i++) {
+        prepare();
+        const Timer timer;
+        task();
+        const double elapsed = timer.ms();
+        if (i == 0 || elapsed < best) { best = elapsed; }
+    }
+    return best;
+}
+template<class Task>
+double best_ms(const int repeat, Task task) { return best_ms(repeat, [] {}, task); }
+
+// 第 index 个命令行参数，没有时为 fallback
+inline size_t arg(const int argc, char** argv, const int index, const size_t fallback) {
+    return index < argc ? static_cast<size_t>(std::strtoull(argv[index], nullptr, 10)) : fallback;
+}
+
+// 结果交给 keep 后编译器不能把计算当作无用代码删掉
+template<class T>
+void keep(const T& value) { asm volatile("" : : "r"(&value) : "memory"); }
+
+// xorshift 伪随机数，各基准程序的输入因此可以复现
+class Random {
+private:
+    uint64_t state;
+
+public:
+    explicit Random(const uint64_t seed = 0x9E3779B97F4A7C15ull) : state(seed) {}
+    uint64_t operator()() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+    uint64_t below(const uint64_t bound) { return (*this)() % bound; }
+};
+
+// 检查失败时打印位置并以非零值退出，基准程序以 ctest 运行时据此判定失败
+#define BENCH_CHECK(condition)                                                                  \
+    do {                                                                                        \
+        if (!(condition)) {                                                                     \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);  \
+            std::exit(1);                                                                       \
+        }                                                                                       \
+    } while (0)
+
+}  // namespace bench
@@ -0,0 +1,237 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "MemoryPool.h"
+
+// 线程安全的内存池：每个线程持有两个弹匣（magazine）缓存槽位，
+// 只有弹匣整体空/满时才与共享的 depot 交换，depot 再按批向底层 MemoryPool 申请或归还。
+// 任意线程都可以释放其他线程分配的槽位，释放只进入当前线程的弹匣，不需要全局锁。
+template<class T>
+class ConcurrentMemoryPool {
+public:
+    static constexpr int MAGAZINE_SIZE = 64;
+    static constexpr int MAX_DEPOT_MAGAZINES = 16;  // depot 中最多保留的满弹匣数，多余的归还给底层内存池
+
+private:
+    struct Magazine {
+        Magazine* next = nullptr;
+        int count = 0;
+        T* slots[MAGAZINE_SIZE];
+    };
+
+    struct ThreadCache {
+        ThreadCache* next = nullptr;
+        ThreadCache* prev = nullptr;
+        Magazine* loaded = new Magazine;
+        Magazine* previous = new Magazine;
+    };
+
+    struct Depot {
+        std::mutex lock;
+        MemoryPool<T> backing;
+        Magazine* full = nullptr;
+        Magazine* empty = nullptr;
+        int full_num = 0;
+        ThreadCache* caches = nullptr;  // 已注册的线程缓存，线程退出时摘除
+
+        ~Depot() {
+            while (caches != nullptr) {
+                ThreadCache* temp = caches->next;
+                delete caches->loaded;
+                delete caches->previous;
+                delete caches;
+                caches = temp;
+            }
+            delete_list(full);
+            delete_list(empty);
+        }
+
+        static void delete_list(Magazine* list) {
+            while (list != nullptr) {
+                Magazine* temp = list->next;
+                delete list;
+                list = temp;
+            }
+        }
+        static void push(Magazine*& list, Magazine* magazine) {
+            magazine->next = list;
+            list = magazine;
+        }
+        static Magazine* pop(Magazine*& list) {
+            Magazine* magazine = list;
+            list = magazine->next;
+            return magazine;
+        }
+
+        // 以下函数均需持有 lock
+        void fill(Magazine* magazine) {
+            while (magazine->count < MAGAZINE_SIZE) {
+                magazine->slots[magazine->count++] = backing.allocate();
+            }
+        }
+        void drain(Magazine* magazine) {
+            while (magazine->count > 0) {
+                backing.deallocate(magazine->slots[--magazine->count]);
+            }
+        }
+        void release(ThreadCache* cache) {
+            drain(cache->loaded);
+            drain(cache->previous);
+            push(empty, cache->loaded);
+            push(empty, cache->previous);
+            if (cache->prev != nullptr) { cache->prev->next = cache->next; }
+            else { caches = cache->next; }
+            if (cache->next != nullptr) { cache->next->prev = cache->prev; }
+            delete cache;
+        }
+    };
+
+    // 每个线程记录自己访问过的内存池及对应的缓存，线程退出时把缓存归还给仍然存活的内存池
+    struct Registry {
+        struct Entry {
+            Entry* next;
+            uint64_t id;
+            std::weak_ptr<Depot> depot;
+            ThreadCache* cache;
+        };
+        Entry* entries = nullptr;
+        uint64_t last_id = 0;
+        ThreadCache* last_cache = nullptr;
+
+        ~Registry() {
+            while (entries != nullptr) {
+                Entry* temp = entries->next;
+                if (std::shared_ptr<Depot> depot = entries->depot.lock()) {
+                    std::lock_guard<std::mutex> guard(depot->lock);
+                    depot->release(entries->cache);
+                }
+                delete entries;
+                entries = temp;
+            }
+        }
+    };
+
+    static Registry& registry() {
+        static thread_local Registry local;
+        return local;
+    }
+
+    static uint64_t next_id() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
+    std::shared_ptr<Depot> depot;
+    uint64_t id;
+
+    ThreadCache* cache() {
+        Registry& local = registry();
+        if (local.last_id == id) { return local.last_cache; }
+
+        typename Registry::Entry** link = &local.entries;
+        while (*link != nullptr) {
+            typename Registry::Entry* entry = *link;
+            if (entry->id == id) {
+                local.last_id = id;
+                local.last_cache = entry->cache;
+                return entry->cache;
+            }
+            if (entry->depot.expired()) {
+                // 对应的内存池已经析构，顺便清理
+                *link = entry->next;
+                delete entry;
+            }
+            else { link = &entry->next; }
+        }
+
+        ThreadCache* created = new ThreadCache;
+        {
+            std::lock_guard<std::mutex> guard(depot->lock);
+            created->next = depot->caches;
+            if (depot->caches != nullptr) { depot->caches->prev = created; }
+            depot->caches = created;
+        }
+        local.entries = new typename Registry::Entry{local.entries, id, depot, created};
+        local.last_id = id;
+        local.last_cache = created;
+        return created;
+    }
+
+public:
+    ConcurrentMemoryPool() : depot(std::make_shared<Depot>()), id(next_id()) {}
+    ~ConcurrentMemoryPool() = default;
+
+    ConcurrentMemoryPool(const ConcurrentMemoryPool&) = delete;
+    ConcurrentMemoryPool& operator=(const ConcurrentMemoryPool&) = delete;
+
+    T* allocate() {
+        ThreadCache* local = cache();
+        if (local->loaded->count == 0) {
+            if (local->previous->count > 0) { std::swap(local->loaded, local->previous); }
+            else {
+                // 两个弹匣都空了：用空弹匣从 depot 换一个满的，没有则从底层内存池批量填充
+                std::lock_guard<std::mutex> guard(depot->lock);
+                if (depot->full != nullptr) {
+                    Depot::push(depot->empty, local->previous);
+                    local->previous = local->loaded;
+                    local->loaded = Depot::pop(depot->full);
+                    depot->full_num--;
+                }
+                else { depot->fill(local->loaded); }
+            }
+        }
+        return local->loaded->slots[--local->loaded->count];
+    }
+
+    void deallocate(T* ptr) {
+        ThreadCache* local = cache();
+        if (local->loaded->count == MAGAZINE_SIZE) {
+            if (local->previous->count < MAGAZINE_SIZE) { std::swap(local->loaded, local->previous); }
+            else {
+                // 两个弹匣都满了：把一个满弹匣交给 depot，换回一个空的
+                std::lock_guard<std::mutex> guard(depot->lock);
+                if (depot->full_num >= MAX_DEPOT_MAGAZINES) { depot->drain(local->previous); }
+                else {
+                    Depot::push(depot->full, local->previous);
+                    depot->full_num++;
+                    local->previous = depot->empty != nullptr ? Depot::pop(depot->empty) : new Magazine;
+                }
+                std::swap(local->loaded, local->previous);
+            }
+        }
+        local->loaded->slots[local->loaded->count++] = ptr;
+    }
+
+    template<class... Args>
+    T* construct(Args&&... args) {
+        T* ptr = allocate();
+        try { new (ptr) T(std::forward<Args>(args)...); }
+        catch (...) {
+            deallocate(ptr);
+            throw;
+        }
+        return ptr;
+    }
+
+    void destroy(T* ptr) {
+        ptr->~T();
+        deallocate(ptr);
+    }
+
+    // 底层内存池的统计，线程弹匣和 depot 中缓存的槽位也计为 live
+    [[nodiscard]] MemoryPoolStats stats() const {
+        std::lock_guard<std::mutex> guard(depot->lock);
+        return depot->backing.stats();
+    }
+
+    // 把当前线程缓存的槽位全部还给底层内存池
+    void flush() {
+        ThreadCache* local = cache();
+        std::lock_guard<std::mutex> guard(depot->lock);
+        depot->drain(local->loaded);
+        depot->drain(local->previous);
+    }
+};
@@ -0,0 +1,83 @@
+// ConcurrentMemoryPool 随线程数的扩展性：每个线程做相同数量的分配 / 释放，
+// 与 new / delete 以及一把全局锁保护的 MemoryPool 对比总吞吐量。
+// 用法：ConcurrentMemoryPoolBench [每个线程的操作数] [最大线程数]，
+// 默认 2000000 次，线程数从 1 倍增到硬件线程数与 8 中的较大者
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Bench.h"
+#include "ConcurrentMemoryPool.h"
+#include "MemoryPool.h"
+#include "MyVector.h"
+
+struct Node {
+    Node* next;
+    long value[3];
+};
+
+static constexpr size_t BATCH = 256;  // 每个线程一次持有的对象数
+
+struct HeapPool {
+    Node* allocate() { return static_cast<Node*>(::operator new(sizeof(Node))); }
+    void deallocate(Node* ptr) { ::operator delete(ptr); }
+};
+
+struct LockedPool {
+    std::mutex lock;
+    MemoryPool<Node> pool;
+
+    Node* allocate() {
+        std::lock_guard<std::mutex> guard(lock);
+        return pool.allocate();
+    }
+    void deallocate(Node* ptr) {
+        std::lock_guard<std::mutex> guard(lock);
+        pool.deallocate(ptr);
+    }
+};
+
+// threads 个线程各做 ops 次分配和释放，返回每毫秒完成的分配次数
+template<class Pool>
+double throughput(Pool& pool, const size_t threads, const size_t ops) {
+    auto work = [&] {
+        Node* nodes[BATCH];
+        for (size_t done = 0; done < ops; done += BATCH) {
+            for (size_t i = 0; i < BATCH; i++) {
+                nodes[i] = pool.allocate();
+                nodes[i]->value[0] = static_cast<long>(i);
+            }
+            for (size_t i = 0; i < BATCH; i++) {
+                BENCH_CHECK(nodes[i]->value[0] == static_cast<long>(i));
+                pool.deallocate(nodes[i]);
+            }
+        }
+    };
+    const double ms = bench::best_ms(3, [&] {
+        std::vector<std::thread> pool_threads;
+        for (size_t t = 1; t < threads; t++) { pool_threads.emplace_back(work); }
+        work();
+        for (auto& thread : pool_threads) { thread.join(); }
+    });
+    return static_cast<double>(threads * ((ops + BATCH - 1) / BATCH * BATCH)) / ms;
+}
+
+int main(const int argc, char** argv) {
+    const size_t ops = bench::arg(argc, argv, 1, 2000000);
+    const size_t hardware = std::thread::hardware_concurrency();
+    const size_t max_threads = bench::arg(argc, argv, 2, std::max<size_t>(hardware, 8));
+    std::printf("%zu allocations per thread, %zu hardware threads\n", ops, hardware);
+    std::printf("%-8s %18s %18s %18s\n", "threads", "Concurrent (op/ms)", "locked (op/ms)", "new/delete (op/ms)");
+    double base = 0;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        ConcurrentMemoryPool<Node> concurrent;
+        LockedPool locked;
+        HeapPool heap;
+        const double result = throughput(concurrent, threads, ops);
+        if (threads == 1) { base = result; }
+        std::printf("%-8zu %12.0f x%-4.2f %18.0f %18.0f\n", threads, result, result / base,
+                    throughput(locked, threads, ops), throughput(heap, threads, ops));
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+// ConcurrentMemoryPool 的多线程压力测试：生产者分配并填写对象后交给消费者，
+// 消费者在另一个线程中检查内容并释放，槽位因此总是跨线程归还。
+// 用法：ConcurrentMemoryPoolTest [每个生产者的对象个数]，默认 200000
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Bench.h"
+#include "ConcurrentMemoryPool.h"
+#include "MyVector.h"
+
+struct Item {
+    uint64_t tag;
+    uint64_t check;  // 始终为 ~tag，两个线程拿到同一个槽位时会被破坏
+};
+
+// 互斥锁保护的栈，生产者与消费者之间的交接处
+class Channel {
+private:
+    std::mutex lock;
+    MyVector<Item*> items;
+
+public:
+    void push(Item* item) {
+        std::lock_guard<std::mutex> guard(lock);
+        items.push_back(item);
+    }
+    Item* pop() {
+        std::lock_guard<std::mutex> guard(lock);
+        if (items.empty()) { return nullptr; }
+        Item* item = items.back();
+        items.pop_back();
+        return item;
+    }
+};
+
+// producers 个生产者各产生 num 个对象，其中一部分自己立即释放，其余交给 consumers 个消费者
+void producer_consumer(const size_t producers, const size_t consumers, const size_t num) {
+    ConcurrentMemoryPool<Item> pool;
+    Channel channel;
+    std::atomic<size_t> running{producers};
+    std::atomic<uint64_t> sent_sum{0};
+    std::atomic<uint64_t> received_sum{0};
+    std::atomic<size_t> received{0};
+    std::atomic<size_t> sent{0};
+
+    auto produce = [&](const uint64_t id) {
+        uint64_t sum = 0;
+        size_t count = 0;
+        for (uint64_t i = 0; i < num; i++) {
+            Item* item = pool.allocate();
+            item->tag = id << 40 | i;
+            item->check = ~item->tag;
+            if (i % 4 == 0) {
+                BENCH_CHECK(item->check == ~item->tag);
+                pool.deallocate(item);
+                continue;
+            }
+            sum += item->tag;
+            count++;
+            channel.push(item);
+        }
+        sent_sum += sum;
+        sent += count;
+        running--;
+    };
+    auto consume = [&] {
+        uint64_t sum = 0;
+        size_t count = 0;
+        while (true) {
+            const bool finished = running.load() == 0;  // 先读标志再取数据，之后取空即可退出
+            Item* item = channel.pop();
+            if (item == nullptr) {
+                if (finished) { break; }
+                std::this_thread::yield();
+                continue;
+            }
+            BENCH_CHECK(item->check == ~item->tag);
+            sum += item->tag;
+            count++;
+            pool.deallocate(item);
+        }
+        received_sum += sum;
+        received += count;
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; p++) { threads.emplace_back(produce, p); }
+    for (size_t c = 0; c < consumers; c++) { threads.emplace_back(consume); }
+    for (auto& thread : threads) { thread.join(); }
+
+    BENCH_CHECK(received.load() == sent.load());
+    BENCH_CHECK(received_sum.load() == sent_sum.load());
+    // 线程退出时缓存已还给底层内存池，剩下的只有 depot 中的满弹匣
+    const MemoryPoolStats stats = pool.stats();
+    BENCH_CHECK(stats.live <= static_cast<size_t>(ConcurrentMemoryPool<Item>::MAX_DEPOT_MAGAZINES *
+                                                   ConcurrentMemoryPool<Item>::MAGAZINE_SIZE));
+    std::printf("%zu producers, %zu consumers: %zu items handed over, %zu slots cached\n",
+                producers, consumers, received.load(), stats.live);
+}
+
+// 线程比内存池活得久：内存池析构后，线程退出时不能再把缓存还给它
+void pool_dies_first(const size_t num) {
+    auto* pool = new ConcurrentMemoryPool<Item>;
+    std::atomic<int> stage{0};
+    std::thread worker([&] {
+        MyVector<Item*> items;
+        for (size_t i = 0; i < num; i++) { items.push_back(pool->allocate()); }
+        for (Item* item : items) { pool->deallocate(item); }
+        stage = 1;
+        while (stage.load() != 2) { std::this_thread::yield(); }
+        ConcurrentMemoryPool<Item> other;  // 新的内存池，线程本地的登记表需要跳过已析构的那个
+        for (size_t i = 0; i < num; i++) { other.deallocate(other.allocate()); }
+    });
+    while (stage.load() != 1) { std::this_thread::yield(); }
+    delete pool;
+    stage = 2;
+    worker.join();
+}
+
+int main(const int argc, char** argv) {
+    const size_t num = bench::arg(argc, argv, 1, 200000);
+    producer_consumer(1, 1, num);
+    producer_consumer(4, 4, num);
+    producer_consumer(2, 6, num);
+    producer_consumer(6, 2, num);
+    pool_dies_first(num);
+    std::puts("ok");
+    return 0;
+}
@@ -0,0 +1,378 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "SortNetwork.h"
+
+// pattern-defeating quicksort（pdqsort，Orson Peters）风格的内省排序，MySort::quick 的实现。
+// - 长度超过 NINTHER_THRESHOLD 时用 Tukey ninther 选主元，否则用三数取中；
+// - 划分后两侧都很不平衡时打乱几个元素，不平衡次数超过 log2(n) 时改用堆排序，最坏 O(n log n)；
+// - 划分时没有发生交换（输入很可能已有序）时先尝试有限步数的插入排序，有序、逆序输入为 O(n)；
+// - 主元与左侧相邻元素相等时把等于主元的元素集中到左侧直接跳过，重复值很多时接近 O(n)；
+// - 算术类型使用分块的无分支划分（BlockQuicksort），避免比较结果难以预测造成的分支误判；
+// - 32 / 64 位整数和浮点数按默认的 < 排序时，不超过 sort_network::MAX_SIZE 的区间用向量化的排序网络代替插入排序
+namespace intro_sort {
+
+static constexpr ptrdiff_t INSERTION_THRESHOLD = 24;
+static constexpr ptrdiff_t NINTHER_THRESHOLD = 128;
+static constexpr ptrdiff_t PARTIAL_INSERTION_LIMIT = 8;
+static constexpr size_t BLOCK_SIZE = 64;
+static constexpr size_t CACHELINE = 64;
+
+template<class T, class Less>
+void insertion_sort(T* first, T* last, Less& less) {
+    if (first == last) { return; }
+    for (T* cur = first + 1; cur != last; ++cur) {
+        T* sift = cur;
+        T* sift_1 = cur - 1;
+        if (less(*sift, *sift_1)) {
+            T temp = std::move(*sift);
+            do { *sift-- = std::move(*sift_1); } while (sift != first && less(temp, *--sift_1));
+            *sift = std::move(temp);
+        }
+    }
+}
+
+// 要求 first 左边的元素不大于 [first, last) 中的任何元素，可以省去边界检查
+template<class T, class Less>
+void unguarded_insertion_sort(T* first, T* last, Less& less) {
+    if (first == last) { return; }
+    for (T* cur = first + 1; cur != last; ++cur) {
+        T* sift = cur;
+        T* sift_1 = cur - 1;
+        if (less(*sift, *sift_1)) {
+            T temp = std::move(*sift);
+            do { *sift-- = std::move(*sift_1); } while (less(temp, *--sift_1));
+            *sift = std::move(temp);
+        }
+    }
+}
+
+// 移动次数超过 PARTIAL_INSERTION_LIMIT 时放弃并返回 false，区间可能只排好了一部分
+template<class T, class Less>
+bool partial_insertion_sort(T* first, T* last, Less& less) {
+    if (first == last) { return true; }
+    ptrdiff_t moved = 0;
+    for (T* cur = first + 1; cur != last; ++cur) {
+        T* sift = cur;
+        T* sift_1 = cur - 1;
+        if (less(*sift, *sift_1)) {
+            T temp = std::move(*sift);
+            do { *sift-- = std::move(*sift_1); } while (sift != first && less(temp, *--sift_1));
+            *sift = std::move(temp);
+            moved += cur - sift;
+        }
+        if (moved > PARTIAL_INSERTION_LIMIT) { return false; }
+    }
+    return true;
+}
+
+template<class T, class Less>
+void sort2(T* a, T* b, Less& less) {
+    if (less(*b, *a)) { std::swap(*a, *b); }
+}
+template<class T, class Less>
+void sort3(T* a, T* b, T* c, Less& less) {
+    sort2(a, b, less);
+    sort2(b, c, less);
+    sort2(a, b, less);
+}
+
+template<class T, class Less>
+void sift_down(T* data, ptrdiff_t root, const ptrdiff_t size, Less& less) {
+    T value = std::move(data[root]);
+    for (ptrdiff_t child = 2 * root + 1; child < size; child = 2 * root + 1) {
+        if (child + 1 < size && less(data[child], data[child + 1])) { ++child; }
+        if (!less(value, data[child])) { break; }
+        data[root] = std::move(data[child]);
+        root = child;
+    }
+    data[root] = std::move(value);
+}
+template<class T, class Less>
+void heap_sort(T* first, T* last, Less& less) {
+    const ptrdiff_t size = last - first;
+    for (ptrdiff_t i = size / 2 - 1; i >= 0; --i) { sift_down(first, i, size, less); }
+    for (ptrdiff_t end = size - 1; end > 0; --end) {
+        std::swap(first[0], first[end]);
+        sift_down(first, 0, end, less);
+    }
+}
+
+template<class T>
+T* align_cacheline(T* ptr) {
+    const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+    return reinterpret_cast<T*>((address + CACHELINE - 1) & ~static_cast<std::uintptr_t>(CACHELINE - 1));
+}
+
+// 按偏移交换左右两侧放错位置的元素。两侧个数相等时必须逐对交换（逆序输入依赖这一点保持 O(n)），
+// 否则用循环移动，每个元素只移动一次
+template<class T>
+void swap_offsets(T* first, T* last, const unsigned char* offsets_l, const unsigned char* offsets_r,
+                  const size_t num, const bool use_swaps) {
+    if (use_swaps) {
+        for (size_t i = 0; i < num; i++) { std::swap(first[offsets_l[i]], *(last - offsets_r[i])); }
+    }
+    else if (num > 0) {
+        T* l = first + offsets_l[0];
+        T* r = last - offsets_r[0];
+        T temp = std::move(*l);
+        *l = std::move(*r);
+        for (size_t i = 1; i < num; i++) {
+            l = first + offsets_l[i];
+            *r = std::move(*l);
+            r = last - offsets_r[i];
+            *l = std::move(*r);
+        }
+        *r = std::move(temp);
+    }
+}
+
+// 以 *first 为主元划分 [first, last)，等于主元的元素放到右侧。返回主元的最终位置，
+// 以及划分前是否已经有序（没有发生交换）。要求 [first, last) 中存在不小于主元的元素作为右侧哨兵
+template<class T, class Less>
+std::pair<T*, bool> partition_right(T* const begin, T* const end, Less& less) {
+    T pivot = std::move(*begin);
+    T* first = begin;
+    T* last = end;
+    while (less(*++first, pivot)) {}
+    if (first - 1 == begin) {
+        while (first < last && !less(*--last, pivot)) {}
+    }
+    else {
+        while (!less(*--last, pivot)) {}
+    }
+    const bool already_partitioned = first >= last;
+    while (first < last) {
+        std::swap(*first, *last);
+        while (less(*++first, pivot)) {}
+        while (!less(*--last, pivot)) {}
+    }
+    T* pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return {pivot_pos, already_partitioned};
+}
+
+// 同 partition_right，但先把放错位置的元素偏移记录在 BLOCK_SIZE 大小的块中再成批交换，比较结果不产生分支
+template<class T, class Less>
+std::pair<T*, bool> partition_right_branchless(T* const begin, T* const end, Less& less) {
+    T pivot = std::move(*begin);
+    T* first = begin;
+    T* last = end;
+    while (less(*++first, pivot)) {}
+    if (first - 1 == begin) {
+        while (first < last && !less(*--last, pivot)) {}
+    }
+    else {
+        while (!less(*--last, pivot)) {}
+    }
+    const bool already_partitioned = first >= last;
+    if (!already_partitioned) {
+        std::swap(*first, *last);
+        ++first;
+
+        unsigned char offsets_l_storage[BLOCK_SIZE + CACHELINE];
+        unsigned char offsets_r_storage[BLOCK_SIZE + CACHELINE];
+        unsigned char* offsets_l = align_cacheline(offsets_l_storage);
+        unsigned char* offsets_r = align_cacheline(offsets_r_storage);
+        T* offsets_l_base = first;
+        T* offsets_r_base = last;
+        size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        while (first < last) {
+            // 一侧的块用完后才重新填充；两侧都空时平分剩余的未知区间
+            const size_t unknown = static_cast<size_t>(last - first);
+            const size_t left_split = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+            const size_t right_split = num_r == 0 ? unknown - left_split : 0;
+
+            if (left_split >= BLOCK_SIZE) {
+                for (size_t i = 0; i < BLOCK_SIZE;) {
+                    for (int k = 0; k < 8; k++) {
+                        offsets_l[num_l] = static_cast<unsigned char>(i++);
+                        num_l += !less(*first, pivot);
+                        ++first;
+                    }
+                }
+            }
+            else {
+                for (size_t i = 0; i < left_split;) {
+                    offsets_l[num_l] = static_cast<unsigned char>(i++);
+                    num_l += !less(*first, pivot);
+                    ++first;
+                }
+            }
+            if (right_split >= BLOCK_SIZE) {
+                for (size_t i = 0; i < BLOCK_SIZE;) {
+                    for (int k = 0; k < 8; k++) {
+                        offsets_r[num_r] = static_cast<unsigned char>(++i);
+                        num_r += less(*--last, pivot);
+                    }
+                }
+            }
+            else {
+                for (size_t i = 0; i < right_split;) {
+                    offsets_r[num_r] = static_cast<unsigned char>(++i);
+                    num_r += less(*--last, pivot);
+                }
+            }
+
+            const size_t num = num_l < num_r ? num_l : num_r;
+            swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r, num,
+                         num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if (num_l == 0) {
+                start_l = 0;
+                offsets_l_base = first;
+            }
+            if (num_r == 0) {
+                start_r = 0;
+                offsets_r_base = last;
+            }
+        }
+
+        // 剩下一侧的块中还有放错位置的元素，逐个换到分界处
+        if (num_l > 0) {
+            offsets_l += start_l;
+            while (num_l-- > 0) { std::swap(offsets_l_base[offsets_l[num_l]], *--last); }
+            first = last;
+        }
+        if (num_r > 0) {
+            offsets_r += start_r;
+            while (num_r-- > 0) {
+                std::swap(*(offsets_r_base - offsets_r[num_r]), *first);
+                ++first;
+            }
+        }
+    }
+    T* pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return {pivot_pos, already_partitioned};
+}
+
+// 把等于主元 *begin 的元素放到左侧，返回主元的最终位置。只在主元等于左侧相邻元素时调用，
+// 此时 [begin, 返回值] 全部等于主元，不需要再排序
+template<class T, class Less>
+T* partition_left(T* const begin, T* const end, Less& less) {
+    T pivot = std::move(*begin);
+    T* first = begin;
+    T* last = end;
+    while (less(pivot, *--last)) {}
+    if (last + 1 == end) {
+        while (first < last && !less(pivot, *++first)) {}
+    }
+    else {
+        while (!less(pivot, *++first)) {}
+    }
+    while (first < last) {
+        std::swap(*first, *last);
+        while (less(pivot, *--last)) {}
+        while (!less(pivot, *++first)) {}
+    }
+    T* pivot_pos = last;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+// leftmost 为 false 时 begin 左边的元素不大于区间中的任何元素，可以作为哨兵
+template<bool BRANCHLESS, bool NETWORK, class T, class Less>
+void sort_loop(T* begin, T* end, Less& less, int bad_allowed, bool leftmost = true) {
+    while (true) {
+        const ptrdiff_t size = end - begin;
+        if constexpr (NETWORK) {
+            if (size <= sort_network::MAX_SIZE) {
+                sort_network::sort(begin, static_cast<size_t>(size));
+                return;
+            }
+        }
+        else if (size < INSERTION_THRESHOLD) {
+            if (leftmost) { insertion_sort(begin, end, less); }
+            else { unguarded_insertion_sort(begin, end, less); }
+            return;
+        }
+
+        // 选出的主元放在 begin
+        const ptrdiff_t half = size / 2;
+        if (size > NINTHER_THRESHOLD) {
+            sort3(begin, begin + half, end - 1, less);
+            sort3(begin + 1, begin + (half - 1), end - 2, less);
+            sort3(begin + 2, begin + (half + 1), end - 3, less);
+            sort3(begin + (half - 1), begin + half, begin + (half + 1), less);
+            std::swap(*begin, *(begin + half));
+        }
+        else { sort3(begin + half, begin, end - 1, less); }
+
+        // 主元等于左侧哨兵：等于主元的元素都已就位，只需处理右侧
+        if (!leftmost && !less(*(begin - 1), *begin)) {
+            begin = partition_left(begin, end, less) + 1;
+            continue;
+        }
+
+        const std::pair<T*, bool> result = BRANCHLESS ? partition_right_branchless(begin, end, less)
+                                                      : partition_right(begin, end, less);
+        T* pivot_pos = result.first;
+        const bool already_partitioned = result.second;
+        const ptrdiff_t l_size = pivot_pos - begin;
+        const ptrdiff_t r_size = end - (pivot_pos + 1);
+
+        if (l_size < size / 8 || r_size < size / 8) {
+            if (--bad_allowed == 0) {
+                heap_sort(begin, end, less);
+                return;
+            }
+            // 打乱两侧的几个元素，破坏导致主元选择失败的模式
+            if (l_size >= INSERTION_THRESHOLD) {
+                std::swap(*begin, *(begin + l_size / 4));
+                std::swap(*(pivot_pos - 1), *(pivot_pos - l_size / 4));
+                if (l_size > NINTHER_THRESHOLD) {
+                    std::swap(*(begin + 1), *(begin + (l_size / 4 + 1)));
+                    std::swap(*(begin + 2), *(begin + (l_size / 4 + 2)));
+                    std::swap(*(pivot_pos - 2), *(pivot_pos - (l_size / 4 + 1)));
+                    std::swap(*(pivot_pos - 3), *(pivot_pos - (l_size / 4 + 2)));
+                }
+            }
+            if (r_size >= INSERTION_THRESHOLD) {
+                std::swap(*(pivot_pos + 1), *(pivot_pos + (1 + r_size / 4)));
+                std::swap(*(end - 1), *(end - r_size / 4));
+                if (r_size > NINTHER_THRESHOLD) {
+                    std::swap(*(pivot_pos + 2), *(pivot_pos + (2 + r_size / 4)));
+                    std::swap(*(pivot_pos + 3), *(pivot_pos + (3 + r_size / 4)));
+                    std::swap(*(end - 2), *(end - (1 + r_size / 4)));
+                    std::swap(*(end - 3), *(end - (2 + r_size / 4)));
+                }
+            }
+        }
+        else if (already_partitioned && partial_insertion_sort(begin, pivot_pos, less) &&
+                 partial_insertion_sort(pivot_pos + 1, end, less)) {
+            return;
+        }
+
+        // 递归处理左侧，循环处理右侧
+        sort_loop<BRANCHLESS, NETWORK>(begin, pivot_pos, less, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+// 比较是否就是 T 的默认 <，排序网络只能代替这种比较
+template<class T, class Less>
+constexpr bool DEFAULT_LESS = std::is_same_v<Less, std::less<>> || std::is_same_v<Less, std::less<T>>;
+
+// 对 [first, last) 按 less 升序排序，不稳定
+template<class T, class Less>
+void sort(T* first, T* last, Less less) {
+    if (last - first < 2) { return; }
+    int bad_allowed = 0;  // floor(log2(n))
+    for (ptrdiff_t n = last - first; n > 1; n >>= 1) { ++bad_allowed; }
+    constexpr bool NETWORK = sort_network::NetworkKey<T> && DEFAULT_LESS<T, Less>;
+    sort_loop<std::is_arithmetic_v<T>, NETWORK>(first, last, less, bad_allowed);
+}
+
+}  // namespace intro_sort
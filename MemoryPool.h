@@ -1,84 +1,309 @@
 #pragma once
-#define START_SIZE 16
-#define MULTIPLE 2
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <utility>
+#include "MyAllocator.h"
 
+// 置为 1 时 MemoryPool 记录分配 / 释放次数、峰值和 slab 的申请 / 归还次数，置为 0 时这些计数完全不存在
+#ifndef MEMORY_POOL_STATS
+#define MEMORY_POOL_STATS 0
+#endif
+
+// MemoryPool::stats() 返回的快照，计数类字段只在 MEMORY_POOL_STATS 打开时有效，其余字段总是有效
+struct MemoryPoolStats {
+    bool counting = false;
+    size_t allocs = 0;
+    size_t frees = 0;
+    size_t peak = 0;              // live 的历史最大值
+    size_t blocks_allocated = 0;
+    size_t blocks_released = 0;
+
+    size_t live = 0;              // 正在使用的槽位
+    size_t blocks = 0;            // 当前持有的 slab 数
+    size_t partial_blocks = 0;    // 部分使用的 slab 数
+    size_t empty_blocks = 0;
+    size_t free_slots = 0;
+    size_t stranded_slots = 0;    // 散落在部分使用的 slab 中、无法随 slab 归还的空闲槽位
+    size_t slots_per_block = 0;
+    size_t bytes_reserved = 0;
+
+    // 碎片率：无法归还的空闲槽位占全部槽位的比例
+    [[nodiscard]] double fragmentation() const {
+        const size_t total = blocks * slots_per_block;
+        return total == 0 ? 0.0 : static_cast<double>(stranded_slots) / static_cast<double>(total);
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const MemoryPoolStats& stats) {
+        if (stats.counting) {
+            out << "allocs=" << stats.allocs << " frees=" << stats.frees << " peak=" << stats.peak
+                << " blocks_allocated=" << stats.blocks_allocated << " blocks_released=" << stats.blocks_released << ' ';
+        }
+        out << "live=" << stats.live << " blocks=" << stats.blocks << " partial_blocks=" << stats.partial_blocks
+            << " empty_blocks=" << stats.empty_blocks << " free_slots=" << stats.free_slots
+            << " stranded_slots=" << stats.stranded_slots << " bytes_reserved=" << stats.bytes_reserved
+            << " fragmentation=" << stats.fragmentation();
+        return out;
+    }
+};
+
+template<bool ENABLE>
+struct MemoryPoolCounters {
+    void on_allocate() {}
+    void on_deallocate() {}
+    void on_new_block() {}
+    void on_delete_block() {}
+    void fill(MemoryPoolStats&) const {}
+};
+
+template<>
+struct MemoryPoolCounters<true> {
+    size_t allocs = 0;
+    size_t frees = 0;
+    size_t live = 0;
+    size_t peak = 0;
+    size_t blocks_allocated = 0;
+    size_t blocks_released = 0;
+
+    void on_allocate() {
+        allocs++;
+        if (++live > peak) { peak = live; }
+    }
+    void on_deallocate() {
+        frees++;
+        live--;
+    }
+    void on_new_block() { blocks_allocated++; }
+    void on_delete_block() { blocks_released++; }
+    void fill(MemoryPoolStats& stats) const {
+        stats.counting = true;
+        stats.allocs = allocs;
+        stats.frees = frees;
+        stats.peak = peak;
+        stats.blocks_allocated = blocks_allocated;
+        stats.blocks_released = blocks_released;
+    }
+};
+
+template<class T, class Alloc>
+class MemoryPool;
+
+// 槽位：空闲时存放下一个空闲槽位的下标，使用时存放对象，大小和对齐取两者的较大值
+template<class T>
+union MemorySlot {
+    int next_free;
+    alignas(T) std::byte storage[sizeof(T)];
+};
+
+// slab：头部与槽位数组位于同一段按 slab 大小对齐的内存中，
+// 槽位地址抹去低位即得所属 slab，因此释放时无需遍历。
+// 槽位不做任何构造，从未用过的槽位按顺序切分，创建 slab 只需申请内存
 template<class T>
 class MemoryBlock {
 private:
-    MemoryBlock* next;
+    template<class, class>
+    friend class MemoryPool;
+    using Slot = MemorySlot<T>;
+    MemoryBlock* next;  // 所在链表（部分空闲 / 已满）中的后继
+    MemoryBlock* prev;
     int capacity;
     int free_num;
-    int free_head;
-    T* first;
+    int free_head;  // 被释放过的槽位组成的链表，-1 表示链表末尾
+    int untouched;  // 从未分配过的槽位的起始下标
+    Slot* first;
 
-public:
-    explicit MemoryBlock(const int start_capacity)
-        : capacity(start_capacity), free_num(start_capacity), next(nullptr), free_head(0) {
-        first = new T[capacity];
-        // 以链表的形式初始化空闲块指针数组
-        for (int i = 0; i < free_num - 1; i++) {
-            *reinterpret_cast<int*>(first + i) = i + 1;
-        }
-        *reinterpret_cast<int*>(first + free_num - 1) = -1;  // 最后一个元素指向 -1，表示链表末尾
-    }
+    MemoryBlock(Slot* slots, const int slot_num)
+        : next(nullptr), prev(nullptr), capacity(slot_num), free_num(slot_num), free_head(-1), untouched(0),
+          first(slots) {}
 
-    ~MemoryBlock() {
-        delete[] first;
-        delete next;
-    }
+public:
+    [[nodiscard]] bool full() const { return free_num == 0; }
+    [[nodiscard]] bool empty() const { return free_num == capacity; }
 
     T* allocate() {
-        if (free_num == 0) {
-            if (next == nullptr) {
-                next = new MemoryBlock(MULTIPLE * capacity);  // 扩展内存池
-            }
-            return next->allocate();
+        Slot* slot;
+        if (free_head != -1) {
+            slot = first + free_head;
+            free_head = slot->next_free;
         }
-        // 分配空闲块
-        int index = free_head;
-        free_head = *reinterpret_cast<int*>(first + free_head);
+        else { slot = first + untouched++; }
         free_num--;
-        return first + index;
+        return reinterpret_cast<T*>(slot->storage);
     }
 
     void deallocate(T* ptr) {
-        if (ptr >= first && ptr < first + capacity) {
-            // 回收该块内存
-            *reinterpret_cast<int*>(ptr) = free_head;
-            free_head = ptr - first;
-            free_num++;
-        } else {
-            if (next != nullptr) {
-                next->deallocate(ptr);  // 递归寻找相应的块
-                // 如果下一块完全空闲且为链表的末尾，释放它
-                if (next->next == nullptr && next->free_num == next->capacity) {
-                    delete next;
-                    next = nullptr;
-                }
-            }
-        }
+        Slot* slot = reinterpret_cast<Slot*>(ptr);
+        slot->next_free = free_head;
+        free_head = static_cast<int>(slot - first);
+        free_num++;
     }
 };
 
-template<class T>
+// 槽位来自按 slab 对齐的内存，slab 本身通过 Alloc 申请，因此也可以建立在 arena 之上。
+// allocate / deallocate 只处理未初始化的内存，construct / destroy 额外负责对象的构造与析构
+template<class T, class Alloc = MyAllocator<T>>
 class MemoryPool {
+public:
+    static constexpr int START_SIZE = 16;
+    static constexpr size_t MIN_SLAB_BYTES = 4096;
+    static constexpr int MAX_EMPTY_SLABS = 1;  // 最多保留的完全空闲 slab 数，避免在边界处反复申请释放
+
 private:
-    MemoryBlock<T>* head;
-    int capacity;
+    using Block = MemoryBlock<T>;
+    using Slot = MemorySlot<T>;
+    static constexpr size_t HEADER_BYTES = (sizeof(Block) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+    static constexpr size_t SLAB_BYTES =
+        std::bit_ceil(std::max(MIN_SLAB_BYTES, HEADER_BYTES + START_SIZE * sizeof(Slot)));
+    static constexpr int SLOT_NUM = static_cast<int>((SLAB_BYTES - HEADER_BYTES) / sizeof(Slot));
+
+    struct alignas(SLAB_BYTES) Slab { std::byte bytes[SLAB_BYTES]; };
+    using SlabAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Slab>;
+    using SlabTraits = std::allocator_traits<SlabAlloc>;
+
+    [[no_unique_address]] SlabAlloc slab_alloc;
+    [[no_unique_address]] MemoryPoolCounters<MEMORY_POOL_STATS != 0> counters;
+    Block* partial;  // 仍有空闲槽位的 slab
+    Block* full;     // 已经分配满的 slab
+    int empty_num;
+
+    static Block* owner(T* ptr) {
+        return reinterpret_cast<Block*>(reinterpret_cast<uintptr_t>(ptr) & ~(SLAB_BYTES - 1));
+    }
+
+    static void link(Block*& list, Block* block) {
+        block->prev = nullptr;
+        block->next = list;
+        if (list != nullptr) { list->prev = block; }
+        list = block;
+    }
+    static void unlink(Block*& list, Block* block) {
+        if (block->prev != nullptr) { block->prev->next = block->next; }
+        else { list = block->next; }
+        if (block->next != nullptr) { block->next->prev = block->prev; }
+    }
+
+    Block* new_block() {
+        void* raw = SlabTraits::allocate(slab_alloc, 1);
+        counters.on_new_block();
+        Slot* slots = reinterpret_cast<Slot*>(static_cast<char*>(raw) + HEADER_BYTES);
+        return new (raw) Block(slots, SLOT_NUM);
+    }
+    void delete_block(Block* block) {
+        counters.on_delete_block();
+        SlabTraits::deallocate(slab_alloc, reinterpret_cast<Slab*>(block), 1);
+    }
+    void delete_list(Block* list) {
+        while (list != nullptr) {
+            Block* temp = list->next;
+            delete_block(list);
+            list = temp;
+        }
+    }
 
 public:
-    explicit MemoryPool(int start_capacity = START_SIZE)
-        : capacity(start_capacity), head(new MemoryBlock<T>(start_capacity)) {}
+    explicit MemoryPool(int start_capacity = START_SIZE, const Alloc& alloc = Alloc())
+        : slab_alloc(alloc), partial(nullptr), full(nullptr), empty_num(0) {
+        do {
+            link(partial, new_block());
+            empty_num++;
+            start_capacity -= SLOT_NUM;
+        } while (start_capacity > 0);
+    }
 
     ~MemoryPool() {
-        delete head;  // delete 会自动调用链表的析构函数
+        delete_list(partial);
+        delete_list(full);
     }
 
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
     T* allocate() {
-        return head->allocate();
+        if (partial == nullptr) {
+            link(partial, new_block());  // 扩展内存池
+            empty_num++;
+        }
+        Block* block = partial;
+        if (block->empty()) { empty_num--; }
+        T* ptr = block->allocate();
+        counters.on_allocate();
+        if (block->full()) {
+            unlink(partial, block);
+            link(full, block);
+        }
+        return ptr;
     }
 
     void deallocate(T* ptr) {
-        head->deallocate(ptr);
+        Block* block = owner(ptr);
+        if (block->full()) {
+            unlink(full, block);
+            link(partial, block);
+        }
+        block->deallocate(ptr);
+        counters.on_deallocate();
+        if (block->empty() && ++empty_num > MAX_EMPTY_SLABS) {
+            // 空闲 slab 过多，归还给系统
+            unlink(partial, block);
+            delete_block(block);
+            empty_num--;
+        }
+    }
+
+    template<class... Args>
+    T* construct(Args&&... args) {
+        T* ptr = allocate();
+        try { new (ptr) T(std::forward<Args>(args)...); }
+        catch (...) {
+            deallocate(ptr);
+            throw;
+        }
+        return ptr;
+    }
+
+    void destroy(T* ptr) {
+        ptr->~T();
+        deallocate(ptr);
+    }
+
+    // 归还所有完全空闲的 slab
+    void trim() {
+        Block* block = partial;
+        while (block != nullptr) {
+            Block* temp = block->next;
+            if (block->empty()) {
+                unlink(partial, block);
+                delete_block(block);
+                empty_num--;
+            }
+            block = temp;
+        }
+    }
+
+    // 计数直接读取，其余信息遍历 slab 链表得到，复杂度与 slab 数成正比
+    [[nodiscard]] MemoryPoolStats stats() const {
+        MemoryPoolStats result;
+        counters.fill(result);
+        result.slots_per_block = SLOT_NUM;
+        for (const Block* block = full; block != nullptr; block = block->next) { result.blocks++; }
+        for (const Block* block = partial; block != nullptr; block = block->next) {
+            result.blocks++;
+            result.free_slots += block->free_num;
+            if (block->empty()) { result.empty_blocks++; }
+            else {
+                result.partial_blocks++;
+                result.stranded_slots += block->free_num;
+            }
+        }
+        result.live = result.blocks * SLOT_NUM - result.free_slots;
+        result.bytes_reserved = result.blocks * SLAB_BYTES;
+        return result;
     }
-};
\ No newline at end of file
+
+    static constexpr int slab_capacity() { return SLOT_NUM; }
+    Alloc get_allocator() const { return Alloc(slab_alloc); }
+};
@@ -0,0 +1,134 @@
+// MemoryPool 与改造前的块链表、new / delete 的分配、释放耗时对比。
+// 用法：MemoryPoolBench [对象个数]，默认 1000000
+#include <cstdio>
+#include <memory>
+#include "Bench.h"
+#include "MemoryPool.h"
+#include "MyVector.h"
+
+struct Node {
+    Node* next;
+    long value[3];
+};
+
+// 分配 num 个对象再按分配顺序全部释放
+template<class Pool>
+double batch(Pool& pool, const size_t num) {
+    MyVector<Node*> nodes(num, nullptr);
+    return bench::best_ms(3, [&] {
+        for (size_t i = 0; i < num; i++) {
+            nodes[i] = pool.allocate();
+            nodes[i]->value[0] = static_cast<long>(i);
+        }
+        for (size_t i = 0; i < num; i++) {
+            BENCH_CHECK(nodes[i]->value[0] == static_cast<long>(i));
+            pool.deallocate(nodes[i]);
+        }
+    });
+}
+
+// 保持约 num / 2 个存活对象，随机释放其中一个再分配一个，释放的槽位分散在各个 slab 中
+template<class Pool>
+double churn(Pool& pool, const size_t num) {
+    const size_t live = num / 2 > 0 ? num / 2 : 1;
+    MyVector<Node*> nodes(live, nullptr);
+    return bench::best_ms(3, [&] {
+        bench::Random random;
+        for (size_t i = 0; i < live; i++) {
+            nodes[i] = pool.allocate();
+            nodes[i]->value[0] = static_cast<long>(i);
+        }
+        for (size_t i = 0; i < num * 4; i++) {
+            const size_t victim = random.below(live);
+            BENCH_CHECK(nodes[victim]->value[0] == static_cast<long>(victim));
+            pool.deallocate(nodes[victim]);
+            nodes[victim] = pool.allocate();
+            nodes[victim]->value[0] = static_cast<long>(victim);
+        }
+        for (size_t i = 0; i < live; i++) { pool.deallocate(nodes[i]); }
+    });
+}
+
+// 改造前的 MemoryPool：容量倍增的块串成链表，释放时沿链表递归查找所属的块
+class ChainBlock {
+private:
+    static constexpr int MULTIPLE = 2;
+    ChainBlock* next;
+    int capacity;
+    int free_num;
+    int free_head;
+    Node* first;
+
+public:
+    explicit ChainBlock(const int start_capacity)
+        : next(nullptr), capacity(start_capacity), free_num(start_capacity), free_head(0), first(new Node[start_capacity]) {
+        // 空闲槽位的下一个下标存放在槽位本身，-1 表示链表末尾
+        for (int i = 0; i < free_num - 1; i++) { *reinterpret_cast<int*>(first + i) = i + 1; }
+        *reinterpret_cast<int*>(first + free_num - 1) = -1;
+    }
+    ~ChainBlock() {
+        delete[] first;
+        delete next;
+    }
+    ChainBlock(const ChainBlock&) = delete;
+    ChainBlock& operator=(const ChainBlock&) = delete;
+
+    Node* allocate() {
+        if (free_num == 0) {
+            if (next == nullptr) { next = new ChainBlock(MULTIPLE * capacity); }
+            return next->allocate();
+        }
+        const int index = free_head;
+        free_head = *reinterpret_cast<int*>(first + free_head);
+        free_num--;
+        return first + index;
+    }
+
+    void deallocate(Node* ptr) {
+        if (ptr >= first && ptr < first + capacity) {
+            *reinterpret_cast<int*>(ptr) = free_head;
+            free_head = static_cast<int>(ptr - first);
+            free_num++;
+        }
+        else if (next != nullptr) {
+            next->deallocate(ptr);
+            // 链表末尾的块完全空闲时释放
+            if (next->next == nullptr && next->free_num == next->capacity) {
+                delete next;
+                next = nullptr;
+            }
+        }
+    }
+};
+
+class ChainPool {
+private:
+    static constexpr int START_SIZE = 16;
+    ChainBlock head{START_SIZE};
+
+public:
+    Node* allocate() { return head.allocate(); }
+    void deallocate(Node* ptr) { head.deallocate(ptr); }
+};
+
+// 与 MemoryPool 接口相同的 new / delete
+struct HeapPool {
+    Node* allocate() { return static_cast<Node*>(::operator new(sizeof(Node))); }
+    void deallocate(Node* ptr) { ::operator delete(ptr); }
+};
+
+int main(const int argc, char** argv) {
+    const size_t num = bench::arg(argc, argv, 1, 1000000);
+    MemoryPool<Node> pool;
+    ChainPool chain;
+    HeapPool heap;
+    std::printf("%zu objects of %zu bytes, slab holds %d\n", num, sizeof(Node), MemoryPool<Node>::slab_capacity());
+    std::printf("%-8s %12s %12s %12s\n", "pattern", "MemoryPool", "block chain", "new/delete");
+    std::printf("%-8s %10.2fms %10.2fms %10.2fms\n", "batch", batch(pool, num), batch(chain, num), batch(heap, num));
+    std::printf("%-8s %10.2fms %10.2fms %10.2fms\n", "churn", churn(pool, num), churn(chain, num), churn(heap, num));
+
+    const MemoryPoolStats stats = pool.stats();
+    BENCH_CHECK(stats.live == 0);
+    BENCH_CHECK(static_cast<int>(stats.empty_blocks) <= MemoryPool<Node>::MAX_EMPTY_SLABS);
+    return 0;
+}
@@ -0,0 +1,269 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// 仿照 std::pmr 的内存资源接口，容器通过 PolyAllocator 把内存请求转发给某个资源
+class MemoryResource {
+public:
+    virtual ~MemoryResource() = default;
+
+    void* allocate(const size_t bytes, const size_t alignment = alignof(std::max_align_t)) {
+        return do_allocate(bytes, alignment);
+    }
+    void deallocate(void* ptr, const size_t bytes, const size_t alignment = alignof(std::max_align_t)) {
+        do_deallocate(ptr, bytes, alignment);
+    }
+    [[nodiscard]] bool is_equal(const MemoryResource& other) const noexcept {
+        return this == &other || do_is_equal(other);
+    }
+
+protected:
+    virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+    virtual void do_deallocate(void* ptr, size_t bytes, size_t alignment) = 0;
+    [[nodiscard]] virtual bool do_is_equal(const MemoryResource& other) const noexcept { return this == &other; }
+};
+
+class NewDeleteResource : public MemoryResource {
+protected:
+    void* do_allocate(const size_t bytes, const size_t alignment) override {
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+    void do_deallocate(void* ptr, const size_t bytes, const size_t alignment) override {
+        ::operator delete(ptr, bytes, std::align_val_t(alignment));
+    }
+    [[nodiscard]] bool do_is_equal(const MemoryResource& other) const noexcept override {
+        return dynamic_cast<const NewDeleteResource*>(&other) != nullptr;
+    }
+};
+
+inline MemoryResource* default_resource() {
+    static NewDeleteResource resource;
+    return &resource;
+}
+
+// 单调增长的 arena：分配只移动指针，单独释放不做任何事，所有内存在 reset / release 时一次性归还
+class MonotonicArena : public MemoryResource {
+private:
+    static constexpr size_t START_SIZE = 1024;
+    static constexpr size_t MULTIPLE = 2;
+
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+    };
+
+    MemoryResource* upstream;
+    Chunk* chunks;       // 最新申请的块在链表头部
+    uintptr_t current;   // 当前块中下一个可用地址
+    uintptr_t end;
+    size_t next_size;
+
+    static uintptr_t align_up(const uintptr_t address, const size_t alignment) {
+        return (address + alignment - 1) & ~(alignment - 1);
+    }
+
+    void grow(const size_t bytes, const size_t alignment) {
+        const size_t need = sizeof(Chunk) + bytes + alignment;
+        while (next_size < need) { next_size *= MULTIPLE; }
+        auto* chunk = static_cast<Chunk*>(upstream->allocate(next_size, alignof(Chunk)));
+        chunk->next = chunks;
+        chunk->size = next_size;
+        chunks = chunk;
+        current = reinterpret_cast<uintptr_t>(chunk + 1);
+        end = reinterpret_cast<uintptr_t>(chunk) + next_size;
+        next_size *= MULTIPLE;
+    }
+
+protected:
+    void* do_allocate(const size_t bytes, const size_t alignment) override {
+        uintptr_t aligned = align_up(current, alignment);
+        if (chunks == nullptr || aligned > end || end - aligned < bytes) {
+            grow(bytes, alignment);
+            aligned = align_up(current, alignment);
+        }
+        current = aligned + bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+    void do_deallocate(void*, size_t, size_t) override {}
+
+public:
+    explicit MonotonicArena(const size_t start_size = START_SIZE, MemoryResource* upstream_ = default_resource())
+        : upstream(upstream_), chunks(nullptr), current(0), end(0), next_size(start_size > 0 ? start_size : START_SIZE) {}
+    ~MonotonicArena() override { release(); }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    // 归还除最新（也是最大）块之外的全部内存，最新块清空后留作下一轮使用
+    void reset() {
+        if (chunks == nullptr) { return; }
+        Chunk* keep = chunks;
+        chunks = chunks->next;
+        release();
+        keep->next = nullptr;
+        chunks = keep;
+        current = reinterpret_cast<uintptr_t>(keep + 1);
+        end = reinterpret_cast<uintptr_t>(keep) + keep->size;
+    }
+    // 归还全部内存
+    void release() {
+        while (chunks != nullptr) {
+            Chunk* temp = chunks->next;
+            upstream->deallocate(chunks, chunks->size, alignof(Chunk));
+            chunks = temp;
+        }
+        current = 0;
+        end = 0;
+    }
+};
+
+// 按 2 的幂划分尺寸等级的池化资源，每个等级维护一条空闲链表，超过 MAX_BLOCK 的请求直接交给上游
+class PoolResource : public MemoryResource {
+public:
+    static constexpr size_t MIN_BLOCK = 8;
+    static constexpr size_t MAX_BLOCK = 1024;
+    static constexpr int START_SLOTS = 16;
+    static constexpr int MAX_SLOTS = 1024;  // 单次向上游申请的最大槽位数
+
+private:
+    static constexpr int CLASS_NUM = std::bit_width(MAX_BLOCK) - std::bit_width(MIN_BLOCK) + 1;
+
+    struct FreeSlot { FreeSlot* next; };
+    struct alignas(std::max_align_t) Chunk {
+        Chunk* next;
+        size_t size;
+    };
+
+    MemoryResource* upstream;
+    Chunk* chunks;
+    FreeSlot* free_list[CLASS_NUM];
+    int next_slots[CLASS_NUM];  // 每个等级下次申请的槽位数，几何增长
+
+    static int class_of(const size_t bytes) {
+        return std::bit_width((bytes > MIN_BLOCK ? bytes : MIN_BLOCK) - 1) - std::bit_width(MIN_BLOCK - 1);
+    }
+    static bool pooled(const size_t bytes, const size_t alignment) {
+        return bytes <= MAX_BLOCK && alignment <= alignof(std::max_align_t);
+    }
+
+    void refill(const int index) {
+        const size_t slot_size = MIN_BLOCK << index;
+        const int slot_num = next_slots[index];
+        const size_t bytes = sizeof(Chunk) + slot_num * slot_size;
+        auto* chunk = static_cast<Chunk*>(upstream->allocate(bytes, alignof(Chunk)));
+        chunk->next = chunks;
+        chunk->size = bytes;
+        chunks = chunk;
+
+        char* first = reinterpret_cast<char*>(chunk + 1);
+        for (int i = slot_num - 1; i >= 0; i--) {
+            auto* slot = reinterpret_cast<FreeSlot*>(first + i * slot_size);
+            slot->next = free_list[index];
+            free_list[index] = slot;
+        }
+        if (next_slots[index] < MAX_SLOTS) { next_slots[index] *= 2; }
+    }
+
+protected:
+    void* do_allocate(const size_t bytes, const size_t alignment) override {
+        if (!pooled(bytes, alignment)) { return upstream->allocate(bytes, alignment); }
+        // 尺寸向上取整到对齐值，保证等级内每个槽位都满足对齐要求
+        const int index = class_of(bytes > alignment ? bytes : alignment);
+        if (free_list[index] == nullptr) { refill(index); }
+        FreeSlot* slot = free_list[index];
+        free_list[index] = slot->next;
+        return slot;
+    }
+    void do_deallocate(void* ptr, const size_t bytes, const size_t alignment) override {
+        if (ptr == nullptr) { return; }
+        if (!pooled(bytes, alignment)) {
+            upstream->deallocate(ptr, bytes, alignment);
+            return;
+        }
+        const int index = class_of(bytes > alignment ? bytes : alignment);
+        auto* slot = static_cast<FreeSlot*>(ptr);
+        slot->next = free_list[index];
+        free_list[index] = slot;
+    }
+
+public:
+    explicit PoolResource(MemoryResource* upstream_ = default_resource()) : upstream(upstream_), chunks(nullptr) {
+        for (int i = 0; i < CLASS_NUM; i++) {
+            free_list[i] = nullptr;
+            next_slots[i] = START_SLOTS;
+        }
+    }
+    ~PoolResource() override { release(); }
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    // 归还所有池化内存，直接交给上游的大块不受影响
+    void release() {
+        while (chunks != nullptr) {
+            Chunk* temp = chunks->next;
+            upstream->deallocate(chunks, chunks->size, alignof(Chunk));
+            chunks = temp;
+        }
+        for (int i = 0; i < CLASS_NUM; i++) {
+            free_list[i] = nullptr;
+            next_slots[i] = START_SLOTS;
+        }
+    }
+};
+
+// 容器的默认分配器，直接使用全局 new / delete，不占用容器空间
+template<class T>
+class MyAllocator {
+public:
+    using value_type = T;
+
+    MyAllocator() = default;
+    template<class U>
+    MyAllocator(const MyAllocator<U>&) noexcept {}
+
+    T* allocate(const size_t n) {
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
+        else { return static_cast<T*>(::operator new(n * sizeof(T))); }
+    }
+    void deallocate(T* ptr, const size_t n) {
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(ptr, n * sizeof(T), std::align_val_t(alignof(T)));
+        }
+        else { ::operator delete(ptr, n * sizeof(T)); }
+    }
+
+    template<class U>
+    bool operator==(const MyAllocator<U>&) const { return true; }
+    template<class U>
+    bool operator!=(const MyAllocator<U>&) const { return false; }
+};
+
+// 从 MemoryResource 取内存的分配器，例如把一次请求内的所有容器都放进同一个 MonotonicArena
+template<class T>
+class PolyAllocator {
+private:
+    MemoryResource* resource_;
+
+public:
+    using value_type = T;
+
+    PolyAllocator() noexcept : resource_(default_resource()) {}
+    PolyAllocator(MemoryResource* resource) noexcept : resource_(resource) {}
+    template<class U>
+    PolyAllocator(const PolyAllocator<U>& other) noexcept : resource_(other.resource()) {}
+
+    T* allocate(const size_t n) { return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T* ptr, const size_t n) { resource_->deallocate(ptr, n * sizeof(T), alignof(T)); }
+
+    [[nodiscard]] MemoryResource* resource() const { return resource_; }
+
+    template<class U>
+    bool operator==(const PolyAllocator<U>& other) const { return resource_->is_equal(*other.resource()); }
+    template<class U>
+    bool operator!=(const PolyAllocator<U>& other) const { return !(*this == other); }
+};
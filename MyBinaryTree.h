@@ -1,7 +1,9 @@
 #pragma once
+#include <memory>
+#include "MyAllocator.h"
 #include "MyStack.h"
 
-template<class T>
+template<class T, class Alloc = MyAllocator<T>>
 class MyBinaryTree {
 public:
     struct Node {
@@ -12,8 +14,22 @@ public:
     };
 
 private:
+    using NodeAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+    [[no_unique_address]] NodeAlloc node_alloc;
     Node* root;
 
+    Node* new_node() {
+        Node* node = NodeTraits::allocate(node_alloc, 1);
+        NodeTraits::construct(node_alloc, node);
+        return node;
+    }
+    void delete_node(Node* node) {
+        NodeTraits::destroy(node_alloc, node);
+        NodeTraits::deallocate(node_alloc, node, 1);
+    }
+
 public:
     class TreeIterator {
         private:
@@ -150,9 +166,9 @@ public:
 
     };
 
-    MyBinaryTree() { root = new Node; }
-    explicit MyBinaryTree(const T& data) {
-        root = new Node;
+    explicit MyBinaryTree(const Alloc& alloc = Alloc()) : node_alloc(alloc) { root = new_node(); }
+    explicit MyBinaryTree(const T& data, const Alloc& alloc = Alloc()) : node_alloc(alloc) {
+        root = new_node();
         root->data = data;
     }
     ~MyBinaryTree() {
@@ -161,7 +177,7 @@ public:
     }
 
     TreeIterator add_lchild(TreeIterator it,const T& data) {
-        it->lchild = new Node;
+        it->lchild = new_node();
         TreeIterator temp(it);
         it.to_left();
         it->parent = temp.get_node();
@@ -169,7 +185,7 @@ public:
         return it;
     }
     TreeIterator add_rchild(TreeIterator it,const T& data) {
-        it->rchild = new Node;
+        it->rchild = new_node();
         TreeIterator temp(it);
         it.to_right();
         it->parent = temp.get_node();
@@ -177,18 +193,25 @@ public:
         return it;
     }
     void delete_tree(TreeIterator it){
-        TreeIterator temp(it);
-    	auto fun = [](TreeIterator iter)->bool{
-	        delete iter.get_node();
-	        return true;
-	    };
-        it.back();
-        if (it->lchild == temp.get_node()) { it->lchild = nullptr; }
-        else {it->rchild = nullptr;}
-    	postorder(temp , fun);
+        Node* node = it.get_node();
+        if (Node* parent = node->parent) {
+            if (parent->lchild == node) { parent->lchild = nullptr; }
+            else { parent->rchild = nullptr; }
+        }
+        // 子节点先入栈再释放当前节点，释放顺序无关紧要
+        MyStack<Node*> stack;
+        stack.push(node);
+        while (!stack.empty()) {
+            Node* temp = stack.top();
+            stack.pop();
+            if (temp->lchild != nullptr) { stack.push(temp->lchild); }
+            if (temp->rchild != nullptr) { stack.push(temp->rchild); }
+            delete_node(temp);
+        }
     }
 
     TreeIterator begin() { return TreeIterator(root); }
+    Alloc get_allocator() const { return Alloc(node_alloc); }
     TreeIterator find(const T& data) {
         PreIterator iter(this->begin());
         while (!iter.is_end()) {
@@ -1,8 +1,10 @@
 #pragma once
+#include <memory>
 #include <stdexcept>
+#include "MyAllocator.h"
 
 
-template<class T>
+template<class T, class Alloc = MyAllocator<T>>
 class MyDeque {
 public:
     class DequeIterator {
@@ -105,6 +107,11 @@ private:
     static constexpr int DATA_ARRAY_SIZE = 16;
     static constexpr int POINTER_ARRAY_SIZE = 16;
     static constexpr int CAPACITY_MULTIPLIER = 2;
+    using Traits = std::allocator_traits<Alloc>;
+    using MapAlloc = typename Traits::template rebind_alloc<T*>;
+    using MapTraits = std::allocator_traits<MapAlloc>;
+
+    [[no_unique_address]] Alloc alloc;
     T** data;
     size_t unit_size;
     size_t size_;
@@ -113,26 +120,47 @@ private:
     DequeIterator first;
     DequeIterator last;
 
+    // 每个数据块整体构造、整体析构
+    T* new_block() {
+        T* block = Traits::allocate(alloc, unit_size);
+        for (size_t i = 0; i < unit_size; i++) { Traits::construct(alloc, block + i); }
+        return block;
+    }
+    void delete_block(T* block) {
+        for (size_t i = 0; i < unit_size; i++) { Traits::destroy(alloc, block + i); }
+        Traits::deallocate(alloc, block, unit_size);
+    }
+    T** new_map(const size_t map_capacity) {
+        MapAlloc map_alloc(alloc);
+        T** map = MapTraits::allocate(map_alloc, map_capacity);
+        for (size_t i = 0; i < map_capacity; i++) { map[i] = nullptr; }
+        return map;
+    }
+    void delete_map(T** map, const size_t map_capacity) {
+        MapAlloc map_alloc(alloc);
+        MapTraits::deallocate(map_alloc, map, map_capacity);
+    }
+
 public:
-    MyDeque()
-        : unit_size(DATA_ARRAY_SIZE), size_(0), capacity(1), data_capacity(POINTER_ARRAY_SIZE + 1) {
-        data = new T*[data_capacity]();
-        data[0] = new T[unit_size];
+    explicit MyDeque(const Alloc& alloc_ = Alloc())
+        : alloc(alloc_), unit_size(DATA_ARRAY_SIZE), size_(0), capacity(1), data_capacity(POINTER_ARRAY_SIZE + 1) {
+        data = new_map(data_capacity);
+        data[0] = new_block();
         first.refresh_iterator(this, &data[0], data[0], data[0]);
         last = first;
     }
 
-    MyDeque(const size_t size, const T& value = 0){
-        MyDeque();
-        for (int i = 0; i < size; ++i) {
+    MyDeque(const size_t size, const T& value = T(), const Alloc& alloc_ = Alloc()) : MyDeque(alloc_) {
+        for (size_t i = 0; i < size; ++i) {
             push_back(value);
         }
     }
 
     MyDeque(const MyDeque& other)
-        : unit_size(other.unit_size), size_(0), capacity(1),data_capacity(POINTER_ARRAY_SIZE) {
-        data = new T*[data_capacity]();
-        data[0] = new T[unit_size];
+        : alloc(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.alloc)),
+          unit_size(other.unit_size), size_(0), capacity(1), data_capacity(POINTER_ARRAY_SIZE) {
+        data = new_map(data_capacity);
+        data[0] = new_block();
         first.refresh_iterator(this, &data[0], data[0], data[0]);
         last.refresh_iterator(this, &data[0], data[0], data[0]);
         DequeIterator it = other.first;
@@ -143,14 +171,13 @@ public:
     }
     ~MyDeque() {
         for (size_t i = 0; i < capacity; i++) {
-            delete[] data[i];
+            delete_block(data[i]);
         }
-        delete[] data;
+        delete_map(data, data_capacity);
     }
 
     MyDeque& operator=(const MyDeque& other) {
         if (this != &other) {
-            unit_size = other.unit_size;
             clear();
             DequeIterator it = other.first;
             while (it != other.last) {
@@ -173,10 +200,10 @@ public:
     [[nodiscard]] size_t size() const { return size_; }
     void clear() {
         for (size_t i = 0; i < capacity; ++i) {
-            delete[] data[i];
+            delete_block(data[i]);
         }
         capacity = 1;
-        data[0] = new T[unit_size];
+        data[0] = new_block();
         size_ = 0;
         first.refresh_iterator(this, &data[0], data[0], data[0]);
         last.refresh_iterator(this, &data[0], data[0], data[0]);
@@ -185,7 +212,7 @@ public:
     void push_back(const T& value) {
         if (last.current == last.first + unit_size - 1) {
             if (capacity == data_capacity) { enlarge_data_capacity(); }
-            data[capacity] = new T[unit_size];
+            data[capacity] = new_block();
             ++capacity;
         }
         *last = value;
@@ -196,7 +223,7 @@ public:
         if (first.current == first.first) {
             if (capacity == data_capacity) { enlarge_data_capacity(); }
             for (size_t i = capacity; i > 0; --i) { data[i] = data[i - 1]; }
-            data[0] = new T[unit_size];
+            data[0] = new_block();
             ++capacity;
             first.refresh_iterator(this, &data[0], data[0] + unit_size, data[0]);
             ++last.node;
@@ -219,16 +246,17 @@ public:
 
     T& front() { return *first; }
     T& back() { DequeIterator temp = last; --temp; return *temp; }
+    Alloc get_allocator() const { return alloc; }
 private:
     void enlarge_data_capacity() {
         const size_t new_capacity = data_capacity * CAPACITY_MULTIPLIER;
-        T** new_data = new T*[new_capacity]();
+        T** new_data = new_map(new_capacity);
         for (size_t i = 0; i < capacity; ++i) {
             new_data[i] = data[i];
             if(&data[i] == first.node) { first.node = &new_data[i]; }
             if (&data[i] == last.node) { last.node = &new_data[i]; }
         }
-        delete[] data;
+        delete_map(data, data_capacity);
         data = new_data;
         data_capacity = new_capacity;
     }
@@ -1,28 +1,50 @@
 #pragma once
+#include <memory>
+#include "MyAllocator.h"
 #include "MyVector.h"
 #include "MyDeque.h"
 #include "MyStack.h"
+#include "MyStringPool.h"
 
-class MyGraph {
+template<class Alloc = MyAllocator<int>>
+class MyBasicGraph {
 private:
-    MyVector<MyVector<int>> adjacency_m;
+    using IntAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<int>;
+    using BoolAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<bool>;
+    using Row = MyVector<int, IntAlloc>;
+    using RowAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Row>;
+    using CharAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<char>;
+    using NamePool = MyBasicStringPool<CharAlloc>;
+
+    MyVector<Row, RowAlloc> adjacency_m;
     size_t size = 0;
+    NamePool names;  // 顶点名字驻留在池中，名字 Id 连续编号
+    MyVector<int, IntAlloc> name_vertex;  // 名字 Id -> 顶点编号
+
+    // 邻接矩阵、遍历用的辅助容器和返回结果都使用同一个分配器
+    IntAlloc int_alloc() const { return IntAlloc(adjacency_m.get_allocator()); }
 
 public:
+    using IntVector = MyVector<int, IntAlloc>;
     static constexpr int POSITIVE_INF = 0x3fffffff;
     static constexpr int NEGATIVE_INF = -0x3fffffff;
 
-    MyGraph() = default;
-    explicit MyGraph(const size_t num) : adjacency_m(MyVector<MyVector<int>>(num, MyVector<int>(num, POSITIVE_INF))), size(num) {}
-    ~MyGraph() = default;
-    MyGraph(const MyGraph& rhs) = default;
-    MyGraph& operator=(const MyGraph& rhs) = default;
-    MyGraph(MyGraph&& rhs) = default;
-    MyGraph& operator=(MyGraph&& rhs) = default;
+    explicit MyBasicGraph(const Alloc& alloc = Alloc())
+        : adjacency_m(RowAlloc(alloc)), names(CharAlloc(alloc)), name_vertex(IntAlloc(alloc)) {}
+    explicit MyBasicGraph(const size_t num, const Alloc& alloc = Alloc())
+        : adjacency_m(num, Row(num, POSITIVE_INF, IntAlloc(alloc)), RowAlloc(alloc)), size(num),
+          names(CharAlloc(alloc)), name_vertex(IntAlloc(alloc)) {}
+    ~MyBasicGraph() = default;
+    MyBasicGraph(const MyBasicGraph& rhs) = default;
+    MyBasicGraph& operator=(const MyBasicGraph& rhs) = default;
+    MyBasicGraph(MyBasicGraph&& rhs) = default;
+    MyBasicGraph& operator=(MyBasicGraph&& rhs) = default;
+
+    Alloc get_allocator() const { return Alloc(adjacency_m.get_allocator()); }
 
     void addVertex(const size_t num = 1) {
         for (int i = 0; i < num; i++) {
-            adjacency_m.push_back(MyVector<int>(num, POSITIVE_INF));
+            adjacency_m.push_back(Row(size, POSITIVE_INF, int_alloc()));
         }
         for (auto& v : adjacency_m) {
             for (int j = 0; j < num; j++) {
@@ -32,6 +54,20 @@ public:
         size += num;
     }
 
+    // 按名字添加顶点，名字已存在时返回已有顶点的编号
+    int addVertex(const MyStringView name) {
+        const typename NamePool::Id id = names.intern(name);
+        if (id < name_vertex.size()) { return name_vertex[id]; }
+        addVertex(1);
+        name_vertex.push_back(static_cast<int>(size - 1));
+        return name_vertex[id];
+    }
+    // 没有这个名字时返回 -1
+    [[nodiscard]] int findVertex(const MyStringView name) const {
+        const typename NamePool::Id id = names.find(name);
+        return id == NamePool::INVALID ? -1 : name_vertex[id];
+    }
+
     void addEdge(const int vertex_from, const int vertex_to, const int weight = 1 , bool directed = false) const {
         if (vertex_from >= 0 && vertex_from < size && vertex_to >= 0 && vertex_to < size) {
             if (adjacency_m[vertex_from][vertex_to] == POSITIVE_INF) {
@@ -71,16 +107,16 @@ public:
 
     [[nodiscard]] size_t getVertexNum() const { return size; }
 
-    [[nodiscard]] MyVector<int> BFS(const int start_vertex) const {
-        if (size == 0) return {};
+    [[nodiscard]] IntVector BFS(const int start_vertex) const {
+        if (size == 0) return IntVector(int_alloc());
         if (start_vertex >= 0 && start_vertex < size) {
-            if (size == 1) return MyVector<int>(1, start_vertex);
+            if (size == 1) return IntVector(1, start_vertex, int_alloc());
 
-            MyVector<int> bfs;
+            IntVector bfs(int_alloc());
             bfs.push_back(start_vertex);
-            MyVector<bool> visited(size, false);
+            MyVector<bool, BoolAlloc> visited(size, false, BoolAlloc(int_alloc()));
             visited[start_vertex] = true;
-            MyDeque<int> deque;
+            MyDeque<int, IntAlloc> deque(int_alloc());
             deque.push_back(start_vertex);
 
             while(!deque.empty()) {
@@ -97,19 +133,19 @@ public:
             }
             return bfs;
         }
-        return {};
+        return IntVector(int_alloc());
     }
 
-    [[nodiscard]] MyVector<int> DFS(const int start_vertex) const {
-        if (size == 0) return {};
+    [[nodiscard]] IntVector DFS(const int start_vertex) const {
+        if (size == 0) return IntVector(int_alloc());
         if (start_vertex >= 0 && start_vertex < size) {
-            if (size == 1) return MyVector<int>(1, start_vertex);
+            if (size == 1) return IntVector(1, start_vertex, int_alloc());
 
-            MyVector<int> dfs;
+            IntVector dfs(int_alloc());
             dfs.push_back(start_vertex);
-            MyVector<bool> visited(size, false);
+            MyVector<bool, BoolAlloc> visited(size, false, BoolAlloc(int_alloc()));
             visited[start_vertex] = true;
-            MyStack<int> stack;
+            MyStack<int, IntAlloc> stack(int_alloc());
             stack.push(start_vertex);
 
             while(!stack.empty()) {
@@ -126,15 +162,15 @@ public:
             }
             return dfs;
         }
-        return {};
+        return IntVector(int_alloc());
     }
 
-    [[nodiscard]] MyVector<int> Topological_Sort() const {
-        if (size == 0) return {};
-        if (size == 1) return MyVector<int>(1, POSITIVE_INF);
-        MyVector<int> result;
-        MyVector<bool> visited(size, false);
-        MyGraph temp = *this;
+    [[nodiscard]] IntVector Topological_Sort() const {
+        if (size == 0) return IntVector(int_alloc());
+        if (size == 1) return IntVector(1, POSITIVE_INF, int_alloc());
+        IntVector result(int_alloc());
+        MyVector<bool, BoolAlloc> visited(size, false, BoolAlloc(int_alloc()));
+        MyBasicGraph temp = *this;
         for (int k = 0; k < size; k++) {
             bool sortable = false;
             for (int i = 0; i < size; i++) {
@@ -158,7 +194,7 @@ public:
                 }
             }
             if (!sortable) {
-                return {};
+                return IntVector(int_alloc());
             }
         }
         return result;
@@ -166,14 +202,14 @@ public:
 
 
 
-    [[nodiscard]] MyVector<int> prim(const int start_vertex) const {
-        if (size == 0) return {};
+    [[nodiscard]] IntVector prim(const int start_vertex) const {
+        if (size == 0) return IntVector(int_alloc());
         if (start_vertex >= 0 && start_vertex < size) {
-            if (size == 1) return MyVector<int>(1, start_vertex);
-            MyVector<int> nearest(size, -1);
-            MyVector<bool> visited(size, false);
+            if (size == 1) return IntVector(1, start_vertex, int_alloc());
+            IntVector nearest(size, -1, int_alloc());
+            MyVector<bool, BoolAlloc> visited(size, false, BoolAlloc(int_alloc()));
             visited[start_vertex] = true;
-            MyVector<int> distance(size, POSITIVE_INF);
+            IntVector distance(size, POSITIVE_INF, int_alloc());
             distance[start_vertex] = 0;
             int current_v = start_vertex;
 
@@ -194,17 +230,17 @@ public:
             }
             return nearest;
         }
-        return {};
+        return IntVector(int_alloc());
     }
 
-    [[nodiscard]] MyVector<int> Dijkstra(const int start_vertex) const {
-        if (size == 0) return {};
+    [[nodiscard]] IntVector Dijkstra(const int start_vertex) const {
+        if (size == 0) return IntVector(int_alloc());
         if (start_vertex >= 0 && start_vertex < size) {
-            if (size == 1) return MyVector<int>(1, start_vertex);
-            MyVector<int> nearest_prv(size, -1);
-            MyVector<bool> visited(size, false);
+            if (size == 1) return IntVector(1, start_vertex, int_alloc());
+            IntVector nearest_prv(size, -1, int_alloc());
+            MyVector<bool, BoolAlloc> visited(size, false, BoolAlloc(int_alloc()));
             visited[start_vertex] = true;
-            MyVector<int> distance(size, POSITIVE_INF);
+            IntVector distance(size, POSITIVE_INF, int_alloc());
             distance[start_vertex] = 0;
             int current_v = start_vertex;
 
@@ -226,11 +262,11 @@ public:
             }
             return nearest_prv;
         }
-        return {};
+        return IntVector(int_alloc());
     }
 
-    [[nodiscard]] MyGraph Transpose() const{
-        MyGraph transpose(size);
+    [[nodiscard]] MyBasicGraph Transpose() const{
+        MyBasicGraph transpose(size, get_allocator());
         for (int i = 0; i < size; i++) {
             for (int j = 0; j < size; j++) {
                 transpose.adjacency_m[i][j] = adjacency_m[i][j];
@@ -240,5 +276,6 @@ public:
     }
 
     // TODO: removeVertex
-    // TODO: string - vertex map
 };
+
+using MyGraph = MyBasicGraph<>;
@@ -0,0 +1,113 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <concepts>
+#include <type_traits>
+#include "MyStringView.h"
+
+// 64 位哈希：wyhash 风格的乘法折叠（64x64 -> 128 位乘法后高低两半异或）。
+// 长输入每轮处理 48 字节，三路互不依赖的乘法可以并行执行；短输入只做一到两次乘法
+namespace my_hash {
+
+static constexpr uint64_t SECRET[4] = {0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL,
+                                       0x589965cc75374cc3ULL};
+
+// 128 位乘积的低、高 64 位分别写回 a、b
+inline void multiply(uint64_t& a, uint64_t& b) {
+#if defined(__SIZEOF_INT128__)
+    const __uint128_t product = static_cast<__uint128_t>(a) * b;
+    a = static_cast<uint64_t>(product);
+    b = static_cast<uint64_t>(product >> 64);
+#else
+    const uint64_t a_hi = a >> 32, a_lo = static_cast<uint32_t>(a);
+    const uint64_t b_hi = b >> 32, b_lo = static_cast<uint32_t>(b);
+    const uint64_t hh = a_hi * b_hi, hl = a_hi * b_lo, lh = a_lo * b_hi, ll = a_lo * b_lo;
+    const uint64_t middle = (ll >> 32) + static_cast<uint32_t>(hl) + static_cast<uint32_t>(lh);
+    a = (middle << 32) | static_cast<uint32_t>(ll);
+    b = hh + (hl >> 32) + (lh >> 32) + (middle >> 32);
+#endif
+}
+inline uint64_t fold_multiply(uint64_t a, uint64_t b) {
+    multiply(a, b);
+    return a ^ b;
+}
+
+inline uint64_t read64(const char* p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+inline uint64_t read32(const char* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t hash_bytes(const char* p, const size_t n, uint64_t seed = 0) {
+    seed ^= fold_multiply(seed ^ SECRET[0], SECRET[1]);
+    uint64_t a = 0, b = 0;
+    if (n <= 16) {
+        if (n >= 4) {
+            // 首尾各取两个可能重叠的 4 字节，覆盖全部输入
+            const size_t shift = (n >> 3) << 2;
+            a = read32(p) << 32 | read32(p + shift);
+            b = read32(p + n - 4) << 32 | read32(p + n - 4 - shift);
+        }
+        else if (n > 0) {
+            a = static_cast<uint64_t>(static_cast<unsigned char>(p[0])) << 16 |
+                static_cast<uint64_t>(static_cast<unsigned char>(p[n >> 1])) << 8 |
+                static_cast<unsigned char>(p[n - 1]);
+        }
+    }
+    else {
+        size_t rest = n;
+        if (rest > 48) {
+            uint64_t lane1 = seed, lane2 = seed;
+            do {
+                seed = fold_multiply(read64(p) ^ SECRET[1], read64(p + 8) ^ seed);
+                lane1 = fold_multiply(read64(p + 16) ^ SECRET[2], read64(p + 24) ^ lane1);
+                lane2 = fold_multiply(read64(p + 32) ^ SECRET[3], read64(p + 40) ^ lane2);
+                p += 48;
+                rest -= 48;
+            } while (rest > 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (rest > 16) {
+            seed = fold_multiply(read64(p) ^ SECRET[1], read64(p + 8) ^ seed);
+            p += 16;
+            rest -= 16;
+        }
+        a = read64(p + rest - 16);  // 最后 16 字节，可能与已处理部分重叠
+        b = read64(p + rest - 8);
+    }
+    a ^= SECRET[1];
+    b ^= seed;
+    multiply(a, b);
+    return fold_multiply(a ^ SECRET[0] ^ n, b ^ SECRET[1]);
+}
+
+inline uint64_t hash_int(const uint64_t value) { return fold_multiply(value ^ SECRET[0], SECRET[1]); }
+
+}  // namespace my_hash
+
+// 默认的哈希函数对象。字符串统一按 MyStringView 哈希，MyString、MyHashedString、视图和 C 字符串的结果相同，
+// 因此可以用视图在以 MyString 为键的容器中查找（is_transparent）
+struct MyHasher {
+    using is_transparent = void;
+
+    size_t operator()(const MyStringView str) const {
+        return static_cast<size_t>(my_hash::hash_bytes(str.data(), str.size()));
+    }
+    // 自带哈希缓存的类型（如 MyHashedString）直接返回缓存值
+    template<class T>
+        requires requires(const T& value) { { value.hash() } -> std::convertible_to<size_t>; }
+    size_t operator()(const T& value) const { return value.hash(); }
+    template<class T>
+        requires std::is_integral_v<T> || std::is_enum_v<T> ||
+                 (std::is_pointer_v<T> && !std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>)
+    size_t operator()(const T value) const {
+        if constexpr (std::is_pointer_v<T>) { return my_hash::hash_int(reinterpret_cast<uintptr_t>(value)); }
+        else { return static_cast<size_t>(my_hash::hash_int(static_cast<uint64_t>(value))); }
+    }
+};
@@ -0,0 +1,397 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <utility>
+#include "MyAllocator.h"
+#include "MyHash.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// MyHashMap / MyHashSet 共用的开放寻址哈希表。
+// 每个槽位对应一个控制字节：空槽为 EMPTY，占用时存放哈希值的低 7 位。查找从 home 开始线性探测，
+// 每次用 SSE2 比较 16 个控制字节，只有 7 位指纹相同的槽位才比较键，遇到含空槽的一组即停止。
+// 探测是逐槽线性的，删除时把后面的元素往回移（Knuth 算法 R），表中不会留下墓碑
+namespace hash_table {
+
+static constexpr size_t GROUP = 16;
+static constexpr int8_t EMPTY = -128;  // 唯一的负值控制字节
+static constexpr size_t NOT_FOUND = SIZE_MAX;
+
+// ctrl 开始的 GROUP 个控制字节中等于 tag 的位置
+inline uint32_t match(const int8_t* ctrl, const int8_t tag) {
+#if defined(__SSE2__)
+    const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(tag))));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < GROUP; i++) { mask |= static_cast<uint32_t>(ctrl[i] == tag) << i; }
+    return mask;
+#endif
+}
+inline uint32_t match_empty(const int8_t* ctrl) {
+#if defined(__SSE2__)
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))));
+#else
+    return match(ctrl, EMPTY);
+#endif
+}
+
+template<class H, class E>
+concept Transparent = requires {
+    typename H::is_transparent;
+    typename E::is_transparent;
+};
+
+// Slot 是存放的元素，KeyOf::get 取出其中的键
+template<class Slot, class KeyOf, class Hash, class Equal, class Alloc>
+class Table {
+private:
+    static constexpr size_t MAX_LOAD_NUM = 3;  // 负载因子上限 3/4
+    static constexpr size_t MAX_LOAD_DEN = 4;
+
+    using SlotAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Slot>;
+    using CtrlAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<int8_t>;
+    using SlotTraits = std::allocator_traits<SlotAlloc>;
+    using CtrlTraits = std::allocator_traits<CtrlAlloc>;
+
+    [[no_unique_address]] SlotAlloc slot_alloc;
+    [[no_unique_address]] CtrlAlloc ctrl_alloc;
+    [[no_unique_address]] Hash hasher;
+    [[no_unique_address]] Equal equal;
+    Slot* slots = nullptr;   // 未初始化的内存，控制字节非空的位置才有对象
+    int8_t* ctrl = nullptr;  // capacity + GROUP - 1 个字节，末尾重复开头的 GROUP - 1 个，从任意槽位都能读满一组
+    size_t capacity_ = 0;    // 0 或不小于 GROUP 的 2 的幂
+    size_t size_ = 0;
+
+    [[nodiscard]] size_t home(const size_t hash) const { return (hash >> 7) & (capacity_ - 1); }
+    static int8_t tag_of(const size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+
+    void set_ctrl(const size_t index, const int8_t value) {
+        ctrl[index] = value;
+        if (index < GROUP - 1) { ctrl[capacity_ + index] = value; }
+    }
+
+    [[nodiscard]] size_t find_empty(const size_t hash) const {
+        const size_t mask = capacity_ - 1;
+        for (size_t pos = home(hash);; pos = (pos + GROUP) & mask) {
+            const uint32_t empties = match_empty(ctrl + pos);
+            if (empties != 0) { return (pos + __builtin_ctz(empties)) & mask; }
+        }
+    }
+
+    void allocate_arrays(const size_t new_capacity) {
+        slots = SlotTraits::allocate(slot_alloc, new_capacity);
+        ctrl = CtrlTraits::allocate(ctrl_alloc, new_capacity + GROUP - 1);
+        memset(ctrl, EMPTY, new_capacity + GROUP - 1);
+        capacity_ = new_capacity;
+    }
+    void release() {
+        if (slots == nullptr) { return; }
+        destroy_all();
+        SlotTraits::deallocate(slot_alloc, slots, capacity_);
+        CtrlTraits::deallocate(ctrl_alloc, ctrl, capacity_ + GROUP - 1);
+        slots = nullptr;
+        ctrl = nullptr;
+        capacity_ = 0;
+    }
+    void destroy_all() {
+        for (size_t i = 0; i < capacity_ && size_ > 0; i++) {
+            if (ctrl[i] != EMPTY) {
+                SlotTraits::destroy(slot_alloc, slots + i);
+                --size_;
+            }
+        }
+    }
+
+    // 元素逐个移入新表，位置由哈希值重新计算
+    void rehash(const size_t new_capacity) {
+        Slot* old_slots = slots;
+        int8_t* old_ctrl = ctrl;
+        const size_t old_capacity = capacity_;
+        allocate_arrays(new_capacity);
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (old_ctrl[i] == EMPTY) { continue; }
+            const size_t hash = hasher(KeyOf::get(old_slots[i]));
+            const size_t index = find_empty(hash);
+            SlotTraits::construct(slot_alloc, slots + index, std::move(old_slots[i]));
+            SlotTraits::destroy(slot_alloc, old_slots + i);
+            set_ctrl(index, tag_of(hash));
+        }
+        if (old_slots != nullptr) {
+            SlotTraits::deallocate(slot_alloc, old_slots, old_capacity);
+            CtrlTraits::deallocate(ctrl_alloc, old_ctrl, old_capacity + GROUP - 1);
+        }
+    }
+
+    static size_t capacity_for(const size_t count) {
+        size_t result = GROUP;
+        while (count * MAX_LOAD_DEN > result * MAX_LOAD_NUM) { result *= 2; }
+        return result;
+    }
+
+public:
+    class Iterator {
+    private:
+        const Table* table;
+        size_t index;
+
+        void skip() {
+            while (index < table->capacity_ && table->ctrl[index] == EMPTY) { ++index; }
+        }
+
+    public:
+        Iterator() : table(nullptr), index(0) {}
+        Iterator(const Table* table_, const size_t index_) : table(table_), index(index_) { skip(); }
+
+        Slot& operator*() const { return table->slots[index]; }
+        Slot* operator->() const { return table->slots + index; }
+        Iterator& operator++() {
+            ++index;
+            skip();
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator temp = *this;
+            ++*this;
+            return temp;
+        }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+        [[nodiscard]] size_t get_index() const { return index; }
+    };
+
+    explicit Table(const Alloc& alloc = Alloc(), const Hash& hasher_ = Hash(), const Equal& equal_ = Equal())
+        : slot_alloc(alloc), ctrl_alloc(alloc), hasher(hasher_), equal(equal_) {}
+    Table(const Table& other)
+        : slot_alloc(SlotTraits::select_on_container_copy_construction(other.slot_alloc)),
+          ctrl_alloc(CtrlTraits::select_on_container_copy_construction(other.ctrl_alloc)), hasher(other.hasher),
+          equal(other.equal) {
+        if (other.size_ == 0) { return; }
+        allocate_arrays(other.capacity_);
+        // 容量相同，元素放在原来的位置，控制字节整体复制
+        for (size_t i = 0; i < capacity_; i++) {
+            if (other.ctrl[i] == EMPTY) { continue; }
+            try { SlotTraits::construct(slot_alloc, slots + i, other.slots[i]); }
+            catch (...) {
+                release();
+                throw;
+            }
+            ctrl[i] = other.ctrl[i];
+            ++size_;
+        }
+        memcpy(ctrl + capacity_, ctrl, GROUP - 1);
+    }
+    Table(Table&& other) noexcept
+        : slot_alloc(std::move(other.slot_alloc)), ctrl_alloc(std::move(other.ctrl_alloc)),
+          hasher(std::move(other.hasher)), equal(std::move(other.equal)), slots(other.slots), ctrl(other.ctrl),
+          capacity_(other.capacity_), size_(other.size_) {
+        other.slots = nullptr;
+        other.ctrl = nullptr;
+        other.capacity_ = 0;
+        other.size_ = 0;
+    }
+    Table& operator=(Table other) {
+        std::swap(slot_alloc, other.slot_alloc);
+        std::swap(ctrl_alloc, other.ctrl_alloc);
+        std::swap(hasher, other.hasher);
+        std::swap(equal, other.equal);
+        std::swap(slots, other.slots);
+        std::swap(ctrl, other.ctrl);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+    ~Table() { release(); }
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+    [[nodiscard]] bool is_empty() const { return size_ == 0; }
+    Alloc get_allocator() const { return Alloc(slot_alloc); }
+
+    // 保证再放入 count 个元素前不需要扩容
+    void reserve(const size_t count) {
+        const size_t needed = capacity_for(count);
+        if (needed > capacity_) { rehash(needed); }
+    }
+    void clear() {
+        destroy_all();
+        if (ctrl != nullptr) { memset(ctrl, EMPTY, capacity_ + GROUP - 1); }
+    }
+
+    template<class K>
+    [[nodiscard]] size_t find_index(const K& key) const { return size_ == 0 ? NOT_FOUND : find_hashed(key, hasher(key)); }
+
+    template<class K>
+    [[nodiscard]] size_t find_hashed(const K& key, const size_t hash) const {
+        if (size_ == 0) { return NOT_FOUND; }
+        const int8_t tag = tag_of(hash);
+        const size_t mask = capacity_ - 1;
+        for (size_t pos = home(hash);; pos = (pos + GROUP) & mask) {
+            for (uint32_t hits = match(ctrl + pos, tag); hits != 0; hits &= hits - 1) {
+                const size_t index = (pos + __builtin_ctz(hits)) & mask;
+                if (equal(KeyOf::get(slots[index]), key)) { return index; }
+            }
+            if (match_empty(ctrl + pos) != 0) { return NOT_FOUND; }
+        }
+    }
+
+    // 键不存在时用 args 构造新元素（key 在构造前最后一次使用，可以是 args 中将被移动的对象）；
+    // 返回元素下标和是否新插入
+    template<class K, class... Args>
+    std::pair<size_t, bool> emplace_key(const K& key, Args&&... args) {
+        const size_t hash = hasher(key);
+        const size_t found = find_hashed(key, hash);
+        if (found != NOT_FOUND) { return {found, false}; }
+        if ((size_ + 1) * MAX_LOAD_DEN > capacity_ * MAX_LOAD_NUM) { rehash(capacity_for(size_ + 1)); }
+        const size_t index = find_empty(hash);
+        SlotTraits::construct(slot_alloc, slots + index, std::forward<Args>(args)...);
+        set_ctrl(index, tag_of(hash));
+        ++size_;
+        return {index, true};
+    }
+
+    // 删除 index 处的元素，并把同一段探测序列中后面的元素往前移，保持“从 home 到元素之间没有空槽”
+    void erase_index(size_t index) {
+        const size_t mask = capacity_ - 1;
+        SlotTraits::destroy(slot_alloc, slots + index);
+        set_ctrl(index, EMPTY);
+        --size_;
+        for (size_t next = (index + 1) & mask; ctrl[next] != EMPTY; next = (next + 1) & mask) {
+            const size_t start = home(hasher(KeyOf::get(slots[next])));
+            // home 落在循环区间 (index, next] 内时元素不能前移
+            const bool stays = index < next ? (start > index && start <= next) : (start > index || start <= next);
+            if (stays) { continue; }
+            SlotTraits::construct(slot_alloc, slots + index, std::move(slots[next]));
+            SlotTraits::destroy(slot_alloc, slots + next);
+            set_ctrl(index, ctrl[next]);
+            set_ctrl(next, EMPTY);
+            index = next;
+        }
+    }
+
+    Slot& at_index(const size_t index) const { return slots[index]; }
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, capacity_); }
+    Iterator iterator_at(const size_t index) const { return index == NOT_FOUND ? end() : Iterator(this, index); }
+};
+
+}  // namespace hash_table
+
+// 键值对存放在 std::pair<Key, Value> 中，通过迭代器或引用修改键会破坏哈希表。
+// Hash 和 Equal 都是 transparent 时（默认如此），find / contains / erase 可以直接用其他类型查找，
+// 例如以 MyString 为键时用 MyStringView 或 C 字符串查找，不构造临时 MyString
+template<class Key, class Value, class Hash = MyHasher, class Equal = std::equal_to<>,
+         class Alloc = MyAllocator<std::pair<Key, Value>>>
+class MyHashMap {
+private:
+    struct KeyOf {
+        static const Key& get(const std::pair<Key, Value>& slot) { return slot.first; }
+    };
+    using Table = hash_table::Table<std::pair<Key, Value>, KeyOf, Hash, Equal, Alloc>;
+    static constexpr bool TRANSPARENT = hash_table::Transparent<Hash, Equal>;
+
+    Table table;
+
+    bool erase_found(const size_t index) {
+        if (index == hash_table::NOT_FOUND) { return false; }
+        table.erase_index(index);
+        return true;
+    }
+
+public:
+    using Iterator = typename Table::Iterator;
+
+    explicit MyHashMap(const Alloc& alloc = Alloc()) : table(alloc) {}
+    MyHashMap(const Hash& hasher, const Equal& equal, const Alloc& alloc = Alloc()) : table(alloc, hasher, equal) {}
+
+    [[nodiscard]] size_t size() const { return table.size(); }
+    [[nodiscard]] size_t capacity() const { return table.capacity(); }
+    [[nodiscard]] bool is_empty() const { return table.is_empty(); }
+    Alloc get_allocator() const { return table.get_allocator(); }
+    void reserve(const size_t count) { table.reserve(count); }
+    void clear() { table.clear(); }
+
+    // 键已存在时不修改，返回 false
+    bool insert(const Key& key, const Value& value) { return table.emplace_key(key, key, value).second; }
+    bool insert(Key&& key, Value&& value) { return table.emplace_key(key, std::move(key), std::move(value)).second; }
+    // 键不存在时插入，已存在时覆盖值
+    void insert_or_assign(const Key& key, const Value& value) {
+        const auto [index, inserted] = table.emplace_key(key, key, value);
+        if (!inserted) { table.at_index(index).second = value; }
+    }
+    template<class... Args>
+    std::pair<Iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        const auto [index, inserted] = table.emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                                         std::forward_as_tuple(std::forward<Args>(args)...));
+        return {table.iterator_at(index), inserted};
+    }
+    Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+    Iterator find(const Key& key) const { return table.iterator_at(table.find_index(key)); }
+    template<class K> requires TRANSPARENT
+    Iterator find(const K& key) const { return table.iterator_at(table.find_index(key)); }
+    bool contains(const Key& key) const { return table.find_index(key) != hash_table::NOT_FOUND; }
+    template<class K> requires TRANSPARENT
+    bool contains(const K& key) const { return table.find_index(key) != hash_table::NOT_FOUND; }
+
+    // 返回是否删除了元素
+    bool erase(const Key& key) { return erase_found(table.find_index(key)); }
+    template<class K> requires TRANSPARENT
+    bool erase(const K& key) { return erase_found(table.find_index(key)); }
+
+    Iterator begin() const { return table.begin(); }
+    Iterator end() const { return table.end(); }
+};
+
+template<class Key, class Hash = MyHasher, class Equal = std::equal_to<>, class Alloc = MyAllocator<Key>>
+class MyHashSet {
+private:
+    struct KeyOf {
+        static const Key& get(const Key& slot) { return slot; }
+    };
+    using Table = hash_table::Table<Key, KeyOf, Hash, Equal, Alloc>;
+    static constexpr bool TRANSPARENT = hash_table::Transparent<Hash, Equal>;
+
+    Table table;
+
+    bool erase_found(const size_t index) {
+        if (index == hash_table::NOT_FOUND) { return false; }
+        table.erase_index(index);
+        return true;
+    }
+
+public:
+    using Iterator = typename Table::Iterator;
+
+    explicit MyHashSet(const Alloc& alloc = Alloc()) : table(alloc) {}
+    MyHashSet(const Hash& hasher, const Equal& equal, const Alloc& alloc = Alloc()) : table(alloc, hasher, equal) {}
+
+    [[nodiscard]] size_t size() const { return table.size(); }
+    [[nodiscard]] size_t capacity() const { return table.capacity(); }
+    [[nodiscard]] bool is_empty() const { return table.is_empty(); }
+    Alloc get_allocator() const { return table.get_allocator(); }
+    void reserve(const size_t count) { table.reserve(count); }
+    void clear() { table.clear(); }
+
+    // 已存在时返回 false
+    bool insert(const Key& key) { return table.emplace_key(key, key).second; }
+    bool insert(Key&& key) { return table.emplace_key(key, std::move(key)).second; }
+
+    Iterator find(const Key& key) const { return table.iterator_at(table.find_index(key)); }
+    template<class K> requires TRANSPARENT
+    Iterator find(const K& key) const { return table.iterator_at(table.find_index(key)); }
+    bool contains(const Key& key) const { return table.find_index(key) != hash_table::NOT_FOUND; }
+    template<class K> requires TRANSPARENT
+    bool contains(const K& key) const { return table.find_index(key) != hash_table::NOT_FOUND; }
+
+    bool erase(const Key& key) { return erase_found(table.find_index(key)); }
+    template<class K> requires TRANSPARENT
+    bool erase(const K& key) { return erase_found(table.find_index(key)); }
+
+    Iterator begin() const { return table.begin(); }
+    Iterator end() const { return table.end(); }
+};
@@ -0,0 +1,95 @@
+// MyHashMap / MyHashSet 与 std::unordered_map 以及 MyList 线性查找的对比。
+// 用法：MyHashMapBench [键的个数]，默认 1000000；线性查找只取其中至多 2000 个键
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include "Bench.h"
+#include "MyHashMap.h"
+#include "MyList.h"
+#include "MyString.h"
+#include "MyStringView.h"
+#include "MyVector.h"
+
+static constexpr int FIND_ROUNDS = 5;
+static constexpr size_t SCAN_KEYS = 2000;
+
+// 整数键：插入 num 个，再把每个键查找 FIND_ROUNDS 次，返回值的和用于核对
+template<class Map>
+uint64_t integer_keys(const MyVector<uint64_t>& keys, double& ms) {
+    uint64_t sum = 0;
+    ms = bench::best_ms(3, [&] {
+        Map map;
+        for (size_t i = 0; i < keys.size(); i++) { map[keys[i]] = i; }
+        sum = 0;
+        for (int round = 0; round < FIND_ROUNDS; round++) {
+            for (size_t i = 0; i < keys.size(); i++) { sum += map.find(keys[i])->second; }
+        }
+    });
+    return sum;
+}
+
+int main(const int argc, char** argv) {
+    const size_t num = bench::arg(argc, argv, 1, 1000000);
+    bench::Random random;
+    // 键互不相同，查找结果之和因此可以预先算出
+    MyVector<uint64_t> keys;
+    keys.reserve(num);
+    for (size_t i = 0; i < num; i++) { keys.push_back(random() << 20 | i); }
+    const uint64_t expected = FIND_ROUNDS * (num * (num - 1) / 2);
+
+    double mine = 0;
+    double standard = 0;
+    BENCH_CHECK((integer_keys<MyHashMap<uint64_t, uint64_t>>(keys, mine)) == expected);
+    BENCH_CHECK((integer_keys<std::unordered_map<uint64_t, uint64_t>>(keys, standard)) == expected);
+    std::printf("%zu uint64 keys, insert + %d finds each: MyHashMap %.1f ms, std::unordered_map %.1f ms\n",
+                num, FIND_ROUNDS, mine, standard);
+
+    // 字符串键：MyHashMap 用 MyStringView 做异构查找，不构造临时的 MyString
+    MyVector<MyString> names;
+    MyVector<std::string> std_names;
+    names.reserve(num);
+    std_names.reserve(num);
+    for (size_t i = 0; i < num; i++) {
+        std_names.push_back("user/" + std::to_string(keys[i]));
+        names.push_back(MyString(std_names[i].c_str()));
+    }
+    uint64_t sum = 0;
+    mine = bench::best_ms(3, [&] {
+        MyHashMap<MyString, size_t> map;
+        for (size_t i = 0; i < num; i++) { map.insert(names[i], i); }
+        sum = 0;
+        for (size_t i = 0; i < num; i++) { sum += map.find(MyStringView(names[i]))->second; }
+    });
+    BENCH_CHECK(sum == num * (num - 1) / 2);
+    standard = bench::best_ms(3, [&] {
+        std::unordered_map<std::string, size_t> map;
+        for (size_t i = 0; i < num; i++) { map.emplace(std_names[i], i); }
+        sum = 0;
+        for (size_t i = 0; i < num; i++) { sum += map.find(std_names[i])->second; }
+    });
+    BENCH_CHECK(sum == num * (num - 1) / 2);
+    std::printf("%zu string keys, insert + find: MyHashMap %.1f ms, std::unordered_map %.1f ms\n", num, mine, standard);
+
+    // 原先只能在 MyList 中逐个比较查找
+    const size_t scan = num < SCAN_KEYS ? num : SCAN_KEYS;
+    MyList<uint64_t> list;
+    MyHashSet<uint64_t> set;
+    for (size_t i = 0; i < scan; i++) {
+        list.push_back(keys[i]);
+        set.insert(keys[i]);
+    }
+    uint64_t list_sum = 0;
+    uint64_t set_sum = 0;
+    const double list_ms = bench::best_ms(3, [&] {
+        list_sum = 0;
+        for (size_t i = 0; i < scan; i++) { list_sum += *list.find(keys[i]); }
+    });
+    const double set_ms = bench::best_ms(3, [&] {
+        set_sum = 0;
+        for (size_t i = 0; i < scan; i++) { set_sum += *set.find(keys[i]); }
+    });
+    BENCH_CHECK(list_sum == set_sum);
+    std::printf("%zu lookups among %zu keys: MyList linear scan %.3f ms, MyHashSet %.3f ms\n", scan, scan, list_ms, set_ms);
+    return 0;
+}
@@ -0,0 +1,122 @@
+// MyHashMap / MyHashSet 的测试：随机插入、删除、查找与 std::unordered_map 对照，以及以 MyString 为键时的异构查找。
+// 键空间很小，插入和删除反复命中同一段探测序列；另用一个把 home 集中在表尾和表头的哈希，让探测序列绕过 capacity_ 回到表头
+// 用法：MyHashMapTest [随机轮数]，默认 200000
+#include <cstdint>
+#include <cstdio>
+#include <unordered_map>
+#include <unordered_set>
+#include "Bench.h"
+#include "MyHashMap.h"
+#include "MyString.h"
+#include "MyStringView.h"
+
+// home 只落在表尾和表头各 2 个槽位（下标 -2、-1、0、1），指纹取键的低 7 位
+struct TailHasher {
+    size_t operator()(const uint64_t key) const { return static_cast<size_t>((key % 4 - 2) << 7 | (key & 0x7F)); }
+};
+
+// 元素个数、逐个查找和遍历的结果都与模型一致
+template<class Map>
+void check_map(const Map& map, const std::unordered_map<uint64_t, uint64_t>& model, const uint64_t key_space) {
+    BENCH_CHECK(map.size() == model.size());
+    for (uint64_t key = 0; key < key_space; key++) {
+        const auto it = map.find(key);
+        const auto expected = model.find(key);
+        BENCH_CHECK(map.contains(key) == (expected != model.end()));
+        BENCH_CHECK((it == map.end()) == (expected == model.end()));
+        if (it != map.end()) { BENCH_CHECK(it->second == expected->second); }
+    }
+    size_t count = 0;
+    for (const auto& [key, value] : map) {
+        const auto expected = model.find(key);
+        BENCH_CHECK(expected != model.end() && expected->second == value);
+        count++;
+    }
+    BENCH_CHECK(count == model.size());
+}
+
+template<class Map>
+void test_random(const size_t rounds, const uint64_t key_space) {
+    bench::Random random;
+    Map map;
+    std::unordered_map<uint64_t, uint64_t> model;
+    for (size_t round = 0; round < rounds; round++) {
+        const uint64_t key = random.below(key_space);
+        const uint64_t value = random();
+        switch (random.below(6)) {
+            case 0: BENCH_CHECK(map.insert(key, value) == model.emplace(key, value).second); break;
+            case 1:
+                map.insert_or_assign(key, value);
+                model[key] = value;
+                break;
+            case 2:
+                map[key] += value;
+                model[key] += value;
+                break;
+            case 3:
+            case 4: BENCH_CHECK(map.erase(key) == (model.erase(key) == 1)); break;
+            default: {
+                const auto it = map.find(key);
+                BENCH_CHECK((it == map.end()) == !model.contains(key));
+                break;
+            }
+        }
+        if (round % 1024 == 0) {
+            check_map(map, model, key_space);
+            // 复制后的表与原表相同，互不影响
+            Map copy(map);
+            check_map(copy, model, key_space);
+            copy.clear();
+            BENCH_CHECK(copy.is_empty());
+            check_map(map, model, key_space);
+        }
+    }
+    check_map(map, model, key_space);
+    // 逐个删空后表中不应残留元素
+    for (uint64_t key = 0; key < key_space; key++) { BENCH_CHECK(map.erase(key) == (model.erase(key) == 1)); }
+    BENCH_CHECK(map.is_empty() && map.begin() == map.end());
+}
+
+// MyHashSet 与 MyHashMap 共用同一张表，这里只核对插入、删除与成员关系
+void test_set(const size_t rounds) {
+    bench::Random random;
+    MyHashSet<uint64_t, TailHasher, std::equal_to<>> set;
+    std::unordered_set<uint64_t> model;
+    for (size_t round = 0; round < rounds; round++) {
+        const uint64_t key = random.below(48);
+        if (random.below(2) == 0) { BENCH_CHECK(set.insert(key) == model.insert(key).second); }
+        else { BENCH_CHECK(set.erase(key) == (model.erase(key) == 1)); }
+        BENCH_CHECK(set.size() == model.size());
+        BENCH_CHECK(set.contains(key) == model.contains(key));
+    }
+}
+
+// 以 MyString 为键时用 MyStringView 和 C 字符串查找、删除
+void test_transparent() {
+    MyHashMap<MyString, int> map;
+    for (int i = 0; i < 100; i++) { BENCH_CHECK(map.insert(MyString(("key" + std::to_string(i)).c_str()), i)); }
+    const char text[] = "key42 key7 key100";
+    const MyStringView view(text);
+    const MyStringView key42 = view.substr(0, 5);
+    const MyStringView key7 = view.substr(6, 4);
+    const MyStringView key100 = view.substr(11);
+    BENCH_CHECK(map.contains(key42) && map.find(key42)->second == 42);
+    BENCH_CHECK(map.find(key42)->first == key42);
+    BENCH_CHECK(map.contains(key7) && map.find(key7)->second == 7);
+    BENCH_CHECK(!map.contains(key100) && map.find(key100) == map.end());
+    BENCH_CHECK(map.contains("key99") && !map.contains("key"));
+    BENCH_CHECK(map.erase(key7) && !map.erase(key7));
+    BENCH_CHECK(!map.contains(MyString("key7")) && map.size() == 99);
+    BENCH_CHECK(map.erase("key0") && map.size() == 98);
+    BENCH_CHECK(map.find(MyStringView()) == map.end());
+}
+
+int main(const int argc, char** argv) {
+    const size_t rounds = bench::arg(argc, argv, 1, 200000);
+    test_random<MyHashMap<uint64_t, uint64_t>>(rounds, 200);
+    test_random<MyHashMap<uint64_t, uint64_t, TailHasher, std::equal_to<>>>(rounds, 48);
+    test_set(rounds);
+    test_transparent();
+    std::puts("ok");
+    return 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <compare>
+#include <cstring>
+#include <ostream>
+#include "MyHash.h"
+#include "MyString.h"
+
+// 带哈希缓存的只读字符串，用作哈希表的键或需要反复比较的名字。
+// 哈希值在第一次调用 hash() 时计算并保存，与 MyHasher 对同内容视图的结果一致，可以用视图做异构查找。
+// 相等比较先看长度，两边都已缓存哈希时再比较哈希值，最后才比较字符。
+// 缓存的写入不加锁，多个线程共享同一对象时应先调用一次 hash()
+template<class Alloc = MyAllocator<char>>
+class MyBasicHashedString {
+private:
+    using String = MyBasicString<Alloc>;
+
+    String str;
+    mutable size_t hash_ = 0;
+    mutable bool hashed = false;
+
+public:
+    MyBasicHashedString() = default;
+    explicit MyBasicHashedString(const char* other, const Alloc& alloc = Alloc()) : str(other, alloc) {}
+    explicit MyBasicHashedString(const MyStringView other, const Alloc& alloc = Alloc()) : str(other, alloc) {}
+    explicit MyBasicHashedString(const String& other) : str(other) {}
+    explicit MyBasicHashedString(String&& other) : str(std::move(other)) {}
+
+    [[nodiscard]] size_t hash() const {
+        if (!hashed) {
+            hash_ = MyHasher()(MyStringView(str));
+            hashed = true;
+        }
+        return hash_;
+    }
+
+    [[nodiscard]] const String& string() const { return str; }
+    [[nodiscard]] size_t size() const { return str.size(); }
+    [[nodiscard]] bool is_empty() const { return str.is_empty(); }
+    operator MyStringView() const { return str; }
+
+    // 修改内容后缓存失效
+    MyBasicHashedString& operator=(const MyStringView other) {
+        str = other;
+        hashed = false;
+        return *this;
+    }
+    MyBasicHashedString& append(const MyStringView other) {
+        str.append(other);
+        hashed = false;
+        return *this;
+    }
+
+    friend bool operator==(const MyBasicHashedString& lhs, const MyBasicHashedString& rhs) {
+        if (lhs.size() != rhs.size()) { return false; }
+        if (lhs.hashed && rhs.hashed && lhs.hash_ != rhs.hash_) { return false; }
+        return MyStringView(lhs) == MyStringView(rhs);
+    }
+    friend std::strong_ordering operator<=>(const MyBasicHashedString& lhs, const MyBasicHashedString& rhs) {
+        return MyStringView(lhs) <=> MyStringView(rhs);
+    }
+    friend std::ostream& operator<<(std::ostream& out, const MyBasicHashedString& str) {
+        return out << MyStringView(str);
+    }
+};
+
+using MyHashedString = MyBasicHashedString<>;
@@ -1,10 +1,10 @@
 #pragma once
 #include "MyVector.h"
 
-template <typename T>
+template <typename T, typename Alloc = MyAllocator<T>>
 class MyMaxHeap {
     private:
-    MyVector<T> heap;
+    MyVector<T, Alloc> heap;
     size_t size_{};
 
     void heapify() {
@@ -40,7 +40,8 @@ class MyMaxHeap {
     static int rChild(const int index) { return 2 * index + 2; }  // 右子节点索引
     public:
     MyMaxHeap() = default;
-    explicit MyMaxHeap(const MyVector<T> other) {
+    explicit MyMaxHeap(const Alloc& alloc) : heap(alloc) {}
+    explicit MyMaxHeap(const MyVector<T, Alloc> other) {
         heap = other;
         size_ = other.size();
         heapify();
@@ -67,7 +68,7 @@ class MyMaxHeap {
     [[nodiscard]] int size() const { return size_; }
     void clear() { heap.clear(); size_ = 0; }
 
-    MyVector<T> sort() {
+    MyVector<T, Alloc> sort() {
         const int temp = size_;
         for (int i = temp - 1; i > 0; --i) {
             heap.swap(0, i);
@@ -77,14 +78,14 @@ class MyMaxHeap {
         size_ = temp;
         return heap;
     }
-    template <typename U>
-    friend MyVector<U> sort_Vector(MyVector<U>& data);
+    template <typename U, typename A>
+    friend MyVector<U, A> sort_Vector(MyVector<U, A>& data);
 
 };
 
-template <typename T>
-MyVector<T> sort_Vector(MyVector<T>& data) {
-    MyMaxHeap<T> temp;
+template <typename T, typename Alloc>
+MyVector<T, Alloc> sort_Vector(MyVector<T, Alloc>& data) {
+    MyMaxHeap<T, Alloc> temp(data.get_allocator());
     temp.size_ = data.size();
     temp.heap.move(data);
     temp.heapify();
@@ -93,7 +94,7 @@ MyVector<T> sort_Vector(MyVector<T>& data) {
     return data;
 }
 
-template <class T>
+template <class T, class Alloc = MyAllocator<T>>
 class MyMinHeap {
     private:
     class inverse_T {
@@ -108,7 +109,7 @@ class MyMinHeap {
         bool operator>(const inverse_T& other) const { return data < other.data; }
         T& operator*(){ return data; }
     };
-    MyMaxHeap<inverse_T> heap;
+    MyMaxHeap<inverse_T, typename std::allocator_traits<Alloc>::template rebind_alloc<inverse_T>> heap;
 
     public:
     void push(const T& value) { heap.push(value); }
@@ -0,0 +1,146 @@
+#pragma once
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include "MyStringView.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LINE_READER_MMAP 1
+#else
+#define LINE_READER_MMAP 0
+#endif
+
+// 把整个文件映射到内存后逐行读取，每一行都是映射区上的 MyStringView（不含 '\n'，CRLF 换行也不含 '\r'），不复制数据。
+// 需要 MyString 时用 MyString(line) 构造；视图只在 reader 存活期间有效。
+// 没有 mmap 的平台一次性读入堆缓冲区
+class MyLineReader {
+private:
+    const char* ptr = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+
+    void release() {
+#if LINE_READER_MMAP
+        if (mapped) { munmap(const_cast<char*>(ptr), length); }
+#endif
+        if (!mapped) { delete[] ptr; }
+        ptr = nullptr;
+        length = 0;
+        mapped = false;
+    }
+
+    void open_file(const char* path) {
+#if LINE_READER_MMAP
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) { throw std::runtime_error("cannot open file"); }
+        struct stat info {};
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat file");
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0) {
+            void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                ::close(fd);
+                length = 0;
+                throw std::runtime_error("cannot map file");
+            }
+#if defined(MADV_SEQUENTIAL)
+            madvise(address, length, MADV_SEQUENTIAL);  // 顺序扫描，让内核加大预读
+#endif
+            ptr = static_cast<const char*>(address);
+            mapped = true;
+        }
+        ::close(fd);  // 映射建立后不再需要文件描述符
+#else
+        FILE* file = fopen(path, "rb");
+        if (file == nullptr) { throw std::runtime_error("cannot open file"); }
+        fseek(file, 0, SEEK_END);
+        const long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (size > 0) {
+            char* buffer = new char[size];
+            length = fread(buffer, 1, static_cast<size_t>(size), file);
+            ptr = buffer;
+        }
+        fclose(file);
+#endif
+    }
+
+public:
+    class Iterator {
+    private:
+        const char* rest;
+        const char* stop;
+        MyStringView line;
+
+        void advance() {
+            if (rest == stop) {
+                rest = nullptr;
+                return;
+            }
+            const size_t count = static_cast<size_t>(stop - rest);
+            const size_t found = string_search::find_byte(rest, count, '\n');
+            if (found == string_search::NOT_FOUND) {
+                line = MyStringView(rest, count);
+                rest = stop;
+            } else {
+                // CRLF 换行时去掉行尾的 '\r'，行内其他位置的 '\r' 保留
+                line = MyStringView(rest, found > 0 && rest[found - 1] == '\r' ? found - 1 : found);
+                rest += found + 1;
+            }
+        }
+
+    public:
+        Iterator() : rest(nullptr), stop(nullptr) {}
+        Iterator(const char* begin, const char* end) : rest(begin), stop(end) { advance(); }
+
+        MyStringView operator*() const { return line; }
+        const MyStringView* operator->() const { return &line; }
+        Iterator& operator++() {
+            advance();
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator temp = *this;
+            advance();
+            return temp;
+        }
+        bool operator==(const Iterator& other) const { return rest == other.rest; }
+        bool operator!=(const Iterator& other) const { return rest != other.rest; }
+    };
+
+    explicit MyLineReader(const char* path) { open_file(path); }
+    MyLineReader(const MyLineReader&) = delete;
+    MyLineReader& operator=(const MyLineReader&) = delete;
+    MyLineReader(MyLineReader&& other) noexcept : ptr(other.ptr), length(other.length), mapped(other.mapped) {
+        other.ptr = nullptr;
+        other.length = 0;
+        other.mapped = false;
+    }
+    MyLineReader& operator=(MyLineReader&& other) noexcept {
+        if (this != &other) {
+            release();
+            ptr = other.ptr;
+            length = other.length;
+            mapped = other.mapped;
+            other.ptr = nullptr;
+            other.length = 0;
+            other.mapped = false;
+        }
+        return *this;
+    }
+    ~MyLineReader() { release(); }
+
+    [[nodiscard]] MyStringView contents() const { return MyStringView(ptr, length); }
+    [[nodiscard]] size_t size() const { return length; }
+
+    // 以 '\n' 结尾的文件不会多出一个空的末行
+    [[nodiscard]] Iterator begin() const { return ptr == nullptr ? Iterator() : Iterator(ptr, ptr + length); }
+    [[nodiscard]] Iterator end() const { return Iterator(); }
+};
@@ -0,0 +1,50 @@
+// MyLineReader 的测试：LF 与 CRLF 换行、空行、缺少末尾换行符、空文件，逐行结果与预期对照
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "Bench.h"
+#include "MyLineReader.h"
+
+// 把 contents 写入临时文件，逐行读出后与 expected 比较
+void check_lines(const std::string& contents, const std::vector<std::string>& expected) {
+    char path[] = "/tmp/MyLineReaderTestXXXXXX";
+    const int fd = mkstemp(path);
+    BENCH_CHECK(fd >= 0);
+    BENCH_CHECK(write(fd, contents.data(), contents.size()) == static_cast<ssize_t>(contents.size()));
+    close(fd);
+    {
+        const MyLineReader reader(path);
+        BENCH_CHECK(reader.size() == contents.size());
+        size_t count = 0;
+        for (const MyStringView line : reader) {
+            BENCH_CHECK(count < expected.size());
+            BENCH_CHECK(line == MyStringView(expected[count].data(), expected[count].size()));
+            count++;
+        }
+        BENCH_CHECK(count == expected.size());
+    }
+    unlink(path);
+}
+
+int main() {
+    check_lines("", {});
+    check_lines("one\ntwo\n", {"one", "two"});
+    check_lines("one\ntwo", {"one", "two"});
+    check_lines("\n\nx\n", {"", "", "x"});
+    // CRLF 换行去掉行尾的 '\r'，LF 与 CRLF 可以混用
+    check_lines("one\r\ntwo\r\n", {"one", "two"});
+    check_lines("one\r\n\r\ntwo", {"one", "", "two"});
+    check_lines("lf\ncrlf\r\nlf\n", {"lf", "crlf", "lf"});
+    check_lines("\r\n", {""});
+    // 不在换行符前的 '\r' 属于行的内容
+    check_lines("a\rb\r\n", {"a\rb"});
+    check_lines("tail\r", {"tail\r"});
+    check_lines("\r\r\n", {"\r"});
+    // 跨过 SIMD 块边界的长行
+    const std::string row(200, 'x');
+    check_lines(row + "\r\n" + row + "\n" + row, {row, row, row});
+    std::puts("ok");
+    return 0;
+}
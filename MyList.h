@@ -1,16 +1,17 @@
 #pragma once
 #include "MemoryPool.h"
 
-template<class T>
-class MyBinaryTree {
+template<class T, class Alloc = MyAllocator<T>>
+class MyList {
 private:
     struct Node {
         Node* next;
         Node* prev;
         T data;
     };
+    using NodeAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
 
-    MemoryPool<Node> list_pool;
+    MemoryPool<Node, NodeAlloc> list_pool;
     Node* head; // 指向链表的第一个节点
     Node* tail; // 指向链表的尾部哨兵节点
     size_t size_;
@@ -41,24 +42,17 @@ public:
             Node* get_node() const { return current; }  // 返回内部节点
     };
 
-    MyBinaryTree() : size_(0) {
-        Node* sentinel = list_pool.allocate(); // 分配哨兵节点
-        sentinel->next = nullptr;
-        sentinel->prev = nullptr;
+    explicit MyList(const Alloc& alloc = Alloc()) : list_pool(MemoryPool<Node, NodeAlloc>::START_SIZE, alloc), size_(0) {
+        Node* sentinel = list_pool.construct(nullptr, nullptr, T()); // 构造哨兵节点，data 值初始化
         head = sentinel;
         tail = sentinel;
     }
-    MyBinaryTree(const MyBinaryTree& other) : MyBinaryTree() {
-        Node* sentinel = list_pool.allocate();
-        sentinel->next = nullptr;
-        sentinel->prev = nullptr;
-        head = sentinel;
-        tail = sentinel;
+    MyList(const MyList& other) : MyList(other.get_allocator()) {
         for(list_iterator i = other.begin(); i != other.end(); ++i) { push_back(*i); }
     }
-    ~MyBinaryTree() { clear(); list_pool.deallocate(tail); } // 清除所有节点并释放哨兵节点
+    ~MyList() { clear(); list_pool.destroy(tail); } // 清除所有节点并释放哨兵节点
 
-    MyBinaryTree& operator=(const MyBinaryTree& other) {
+    MyList& operator=(const MyList& other) {
         if (this != &other) {
             clear();
             for(list_iterator i = other.begin(); i != other.end(); ++i) { push_back(*i); }
@@ -67,10 +61,7 @@ public:
     }
 
     void push_back(const T& new_data) {
-        Node* temp = list_pool.allocate();
-        temp->data = new_data;
-        temp->next = tail;
-        temp->prev = tail->prev;
+        Node* temp = list_pool.construct(tail, tail->prev, new_data);
 
         if (tail->prev) { tail->prev->next = temp; }
         else { head = temp; }
@@ -79,10 +70,7 @@ public:
         size_++;
     }
     void push_front(const T& new_data) {
-        Node* temp = list_pool.allocate();
-        temp->data = new_data;
-        temp->next = head;
-        temp->prev = nullptr;
+        Node* temp = list_pool.construct(head, nullptr, new_data);
 
         if (head != tail) { head->prev = temp; }
         else { tail->prev = temp; }
@@ -98,7 +86,7 @@ public:
         else { head = tail; }
 
         tail->prev = last_node->prev;
-        list_pool.deallocate(last_node);
+        list_pool.destroy(last_node);
         size_--;
     }
     void pop_front() {
@@ -113,7 +101,7 @@ public:
             tail->prev = nullptr;
         }
 
-        list_pool.deallocate(first_node);
+        list_pool.destroy(first_node);
         size_--;
     }
 
@@ -129,10 +117,7 @@ public:
         }
 
         Node* prev_node = next_node->prev;
-        Node* temp = list_pool.allocate();
-        temp->data = new_data;
-        temp->next = next_node;
-        temp->prev = prev_node;
+        Node* temp = list_pool.construct(next_node, prev_node, new_data);
 
         prev_node->next = temp;
         next_node->prev = temp;
@@ -157,7 +142,7 @@ public:
         prev_node->next = next_node;
         next_node->prev = prev_node;
 
-        list_pool.deallocate(node_to_erase);
+        list_pool.destroy(node_to_erase);
         size_--;
         return list_iterator(next_node);
     }
@@ -174,12 +159,15 @@ public:
     void clear() {
         while (head != tail) {
             Node* temp = head->next;
-            list_pool.deallocate(head);
+            list_pool.destroy(head);
             head = temp;
         }
+        tail->prev = nullptr;
         size_ = 0;
     }
     bool empty() const { return size_ == 0; }
+    Alloc get_allocator() const { return list_pool.get_allocator(); }
+    [[nodiscard]] MemoryPoolStats pool_stats() const { return list_pool.stats(); }
 
     list_iterator begin() const { return list_iterator(head); }
     list_iterator end() const { return list_iterator(tail); }
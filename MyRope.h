@@ -0,0 +1,320 @@
+#pragma once
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include "MyString.h"
+
+namespace rope_detail {
+// MIN_LENGTH[d]：深度为 d 的平衡 rope 至少包含的字符数（Fibonacci 数列 1, 2, 3, 5, ...）
+static constexpr size_t FOREST_SIZE = 91;  // MIN_LENGTH[FOREST_SIZE] 是 size_t 能表示的最大 Fibonacci 数
+
+struct FibonacciTable {
+    size_t value[FOREST_SIZE + 1];
+    constexpr FibonacciTable() : value{} {
+        value[0] = 1;
+        value[1] = 2;
+        for (size_t i = 2; i <= FOREST_SIZE; i++) { value[i] = value[i - 1] + value[i - 2]; }
+    }
+};
+inline constexpr FibonacciTable MIN_LENGTH{};
+}  // namespace rope_detail
+
+// 由 MyString 块组成的不可变二叉树，用于大量拼接（报表、日志聚合），代替反复 operator+ / +=。
+// 节点带引用计数，在 rope 之间共享：复制为 O(1)，拼接、substr 和下标为 O(log n)，都不复制已有字符。
+// 短块拼接时合并成一个叶子（不超过 FLAT_MERGE 字节），逐个字符追加也不会产生大量节点；
+// 深度超过 MAX_DEPTH 时按 Fibonacci 长度重建平衡（Boehm 等人的 rope 算法）。
+// 引用计数不是原子的，共享节点的 rope 不能在多个线程中同时使用
+template<class Alloc = MyAllocator<char>>
+class MyBasicRope {
+public:
+    using String = MyBasicString<Alloc>;
+    static constexpr size_t npos = string_search::NOT_FOUND;
+
+private:
+    static constexpr size_t FLAT_MERGE = 128;
+    static constexpr size_t MAX_DEPTH = 48;
+
+    // 三种节点：叶子持有 text；切片引用另一个叶子的一段（left 指向该叶子）；拼接节点有左右子树
+    struct Node {
+        size_t refs = 1;
+        size_t length = 0;
+        size_t depth = 0;             // 叶子和切片为 0
+        Node* left = nullptr;
+        Node* right = nullptr;
+        const char* chars = nullptr;  // 叶子和切片的字符
+        String text;
+
+        explicit Node(const Alloc& alloc_) : text(alloc_) {}
+        [[nodiscard]] bool is_concat() const { return depth > 0; }
+        [[nodiscard]] MyStringView view() const { return MyStringView(chars, length); }
+    };
+    using NodeAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+    [[no_unique_address]] Alloc alloc;
+    [[no_unique_address]] NodeAlloc node_alloc;
+    Node* root;  // 空 rope 为 nullptr
+
+    Node* new_node() {
+        Node* node = NodeTraits::allocate(node_alloc, 1);
+        NodeTraits::construct(node_alloc, node, alloc);
+        return node;
+    }
+    static Node* retain(Node* node) {
+        if (node != nullptr) { ++node->refs; }
+        return node;
+    }
+    void release(Node* node) {
+        if (node == nullptr || --node->refs > 0) { return; }
+        release(node->left);
+        release(node->right);
+        NodeTraits::destroy(node_alloc, node);
+        NodeTraits::deallocate(node_alloc, node, 1);
+    }
+
+    // text 不能为空
+    Node* make_leaf(String&& text) {
+        Node* node = new_node();
+        node->text = std::move(text);
+        const MyStringView view = node->text;
+        node->chars = view.data();
+        node->length = view.size();
+        return node;
+    }
+    Node* make_leaf(const MyStringView text) { return make_leaf(String(text, alloc)); }
+
+    // 截取叶子或切片 node 的 [offset, offset + count)，短的直接复制，长的共享原来的字符
+    Node* make_slice(Node* node, const size_t offset, const size_t count) {
+        if (count <= FLAT_MERGE) { return make_leaf(MyStringView(node->chars + offset, count)); }
+        Node* slice = new_node();
+        slice->left = retain(node->left != nullptr ? node->left : node);
+        slice->chars = node->chars + offset;
+        slice->length = count;
+        return slice;
+    }
+
+    Node* make_concat(Node* left, Node* right) {
+        Node* node = new_node();
+        node->left = left;
+        node->right = right;
+        node->length = left->length + right->length;
+        node->depth = (left->depth > right->depth ? left->depth : right->depth) + 1;
+        return node;
+    }
+
+    Node* merge_flat(const Node* left, const Node* right) {
+        String text(alloc);
+        text.reserve(left->length + right->length);
+        text.append(left->view());
+        text.append(right->view());
+        return make_leaf(std::move(text));
+    }
+
+    // 拼接 left 和 right 并接管两者的引用；右侧是短块时尽量与左侧最右的叶子合并
+    Node* join(Node* left, Node* right) {
+        if (left == nullptr) { return right; }
+        if (right == nullptr) { return left; }
+        if (!right->is_concat() && right->length <= FLAT_MERGE) {
+            Node* result = nullptr;
+            if (!left->is_concat() && left->length + right->length <= FLAT_MERGE) {
+                result = merge_flat(left, right);
+            }
+            else if (left->is_concat() && !left->right->is_concat() &&
+                     left->right->length + right->length <= FLAT_MERGE) {
+                Node* merged = merge_flat(left->right, right);
+                result = make_concat(retain(left->left), merged);
+            }
+            if (result != nullptr) {
+                release(left);
+                release(right);
+                return result;
+            }
+        }
+        return make_concat(left, right);
+    }
+
+    // 返回 node 中 [start, stop) 的新引用，只沿两条根到叶子的路径新建节点
+    Node* slice(Node* node, const size_t start, const size_t stop) {
+        if (start == 0 && stop == node->length) { return retain(node); }
+        if (!node->is_concat()) { return make_slice(node, start, stop - start); }
+        const size_t middle = node->left->length;
+        if (stop <= middle) { return slice(node->left, start, stop); }
+        if (start >= middle) { return slice(node->right, start - middle, stop - middle); }
+        Node* left = slice(node->left, start, middle);
+        return join(left, slice(node->right, 0, stop - middle));
+    }
+
+    // forest[i] 中 rope 的长度在 [MIN_LENGTH[i], MIN_LENGTH[i + 1]) 之间，按从右到左的顺序依次拼接即得到平衡的树
+    void add_to_forest(Node* node, Node** forest) {
+        using rope_detail::MIN_LENGTH;
+        if (node->is_concat() && node->length < MIN_LENGTH.value[node->depth]) {
+            add_to_forest(node->left, forest);
+            add_to_forest(node->right, forest);
+            return;
+        }
+        // 平衡的子树整体加入：先把更短的槽位合并到它前面，再向上合并直到长度落入所在槽位
+        Node* prefix = nullptr;
+        size_t i = 0;
+        for (; node->length >= MIN_LENGTH.value[i + 1]; i++) {
+            if (forest[i] != nullptr) {
+                prefix = join(forest[i], prefix);
+                forest[i] = nullptr;
+            }
+        }
+        Node* insertee = join(prefix, retain(node));
+        for (;; i++) {
+            if (forest[i] != nullptr) {
+                insertee = join(forest[i], insertee);
+                forest[i] = nullptr;
+            }
+            if (i == rope_detail::FOREST_SIZE - 1 || insertee->length < MIN_LENGTH.value[i + 1]) {
+                forest[i] = insertee;
+                return;
+            }
+        }
+    }
+
+    // 右侧路径上的节点只被本 rope 引用、且最右的叶子放得下时，直接追加到该叶子，不新建节点
+    bool append_in_place(const MyStringView text) {
+        Node* node = root;
+        while (node != nullptr && node->refs == 1 && node->is_concat()) { node = node->right; }
+        if (node == nullptr || node->refs != 1 || node->left != nullptr || node->length + text.size() > FLAT_MERGE) {
+            return false;
+        }
+        node->text.append(text);
+        node->chars = MyStringView(node->text).data();
+        for (Node* spine = root; spine != node; spine = spine->right) { spine->length += text.size(); }
+        node->length += text.size();
+        return true;
+    }
+
+    void append_node(Node* node) {
+        root = join(root, node);
+        if (root != nullptr && root->depth > MAX_DEPTH) { rebalance(); }
+    }
+
+    template<class F>
+    static void visit(const Node* node, F& func) {
+        if (node->is_concat()) {
+            visit(node->left, func);
+            visit(node->right, func);
+        }
+        else { func(node->view()); }
+    }
+
+public:
+    MyBasicRope() : root(nullptr) {}
+    explicit MyBasicRope(const Alloc& alloc_) : alloc(alloc_), node_alloc(alloc_), root(nullptr) {}
+    explicit MyBasicRope(const MyStringView text, const Alloc& alloc_ = Alloc())
+        : alloc(alloc_), node_alloc(alloc_), root(nullptr) {
+        if (!text.is_empty()) { root = make_leaf(text); }
+    }
+    // 直接接管 text 的缓冲区作为一个叶子
+    explicit MyBasicRope(String&& text) : alloc(text.get_allocator()), node_alloc(alloc), root(nullptr) {
+        if (!text.is_empty()) { root = make_leaf(std::move(text)); }
+    }
+    MyBasicRope(const MyBasicRope& other) : alloc(other.alloc), node_alloc(other.node_alloc), root(retain(other.root)) {}
+    MyBasicRope(MyBasicRope&& other) noexcept
+        : alloc(std::move(other.alloc)), node_alloc(std::move(other.node_alloc)), root(other.root) {
+        other.root = nullptr;
+    }
+    ~MyBasicRope() { release(root); }
+
+    MyBasicRope& operator=(MyBasicRope other) {
+        std::swap(alloc, other.alloc);
+        std::swap(node_alloc, other.node_alloc);
+        std::swap(root, other.root);
+        return *this;
+    }
+
+    [[nodiscard]] size_t size() const { return root == nullptr ? 0 : root->length; }
+    [[nodiscard]] bool is_empty() const { return root == nullptr; }
+    [[nodiscard]] size_t depth() const { return root == nullptr ? 0 : root->depth; }
+    Alloc get_allocator() const { return alloc; }
+
+    // O(depth) 下标访问
+    char operator[](size_t index) const {
+        const Node* node = root;
+        while (node->is_concat()) {
+            if (index < node->left->length) { node = node->left; }
+            else {
+                index -= node->left->length;
+                node = node->right;
+            }
+        }
+        return node->chars[index];
+    }
+    [[nodiscard]] char at(const size_t index) const {
+        if (index >= size()) { throw std::out_of_range("rope index out of range"); }
+        return (*this)[index];
+    }
+
+    // [pos, pos + count) 与末尾取较小者，与原 rope 共享字符
+    [[nodiscard]] MyBasicRope substr(const size_t pos, const size_t count = npos) const {
+        if (pos > size()) { throw std::out_of_range("substr position out of range"); }
+        const size_t rest = size() - pos;
+        MyBasicRope result(alloc);
+        if (count > 0 && rest > 0) {
+            result.root = result.slice(root, pos, pos + (count < rest ? count : rest));
+        }
+        return result;
+    }
+
+    MyBasicRope& append(const MyBasicRope& other) {
+        append_node(retain(other.root));
+        return *this;
+    }
+    MyBasicRope& append(const MyStringView text) {
+        if (!text.is_empty() && !append_in_place(text)) { append_node(make_leaf(text)); }
+        return *this;
+    }
+    MyBasicRope& append(const char* text) { return append(MyStringView(text)); }
+    MyBasicRope& append(String&& text) {
+        if (!text.is_empty()) { append_node(make_leaf(std::move(text))); }
+        return *this;
+    }
+    MyBasicRope& operator+=(const MyBasicRope& other) { return append(other); }
+    MyBasicRope& operator+=(const MyStringView text) { return append(text); }
+    MyBasicRope& operator+=(const char* text) { return append(text); }
+    MyBasicRope& operator+=(String&& text) { return append(std::move(text)); }
+    MyBasicRope& operator+=(const char ch) { return append(MyStringView(&ch, 1)); }
+
+    MyBasicRope operator+(const MyBasicRope& other) const { return MyBasicRope(*this).append(other); }
+    MyBasicRope operator+(const MyStringView text) const { return MyBasicRope(*this).append(text); }
+    MyBasicRope operator+(const char* text) const { return MyBasicRope(*this).append(text); }
+
+    // 按 Fibonacci 长度重建为平衡的树，叶子本身不复制
+    void rebalance() {
+        if (root == nullptr) { return; }
+        Node* forest[rope_detail::FOREST_SIZE] = {};
+        add_to_forest(root, forest);
+        Node* result = nullptr;
+        for (Node* tree : forest) {
+            if (tree != nullptr) { result = join(tree, result); }
+        }
+        release(root);
+        root = result;
+    }
+
+    // 从左到右把每个块作为 MyStringView 交给 func
+    template<class F>
+    void for_each_chunk(F func) const {
+        if (root != nullptr) { visit(root, func); }
+    }
+
+    // 一次申请好空间后按块复制
+    [[nodiscard]] String flatten() const {
+        String result(alloc);
+        result.reserve(size());
+        for_each_chunk([&result](const MyStringView chunk) { result.append(chunk); });
+        return result;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const MyBasicRope& rope) {
+        rope.for_each_chunk([&out](const MyStringView chunk) { out << chunk; });
+        return out;
+    }
+};
+
+using MyRope = MyBasicRope<>;
@@ -0,0 +1,110 @@
+// MyRope 的测试：随机追加、自身拼接、substr 与 rebalance 之后，flatten、下标和 substr 的结果与 std::string 模型对照
+// 用法：MyRopeTest [随机轮数]，默认 3000
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include "Bench.h"
+#include "MyRope.h"
+
+static constexpr size_t MAX_LENGTH = 1 << 18;  // 自身拼接会让长度翻倍，超过后截取一段继续
+
+std::string random_text(bench::Random& random, const size_t length) {
+    std::string text(length, 'a');
+    for (char& ch : text) { ch = static_cast<char>('a' + random.below(26)); }
+    return text;
+}
+
+void check(const MyRope& rope, const std::string& model, bench::Random& random) {
+    BENCH_CHECK(rope.size() == model.size());
+    BENCH_CHECK(rope.is_empty() == model.empty());
+    const MyString flat = rope.flatten();
+    BENCH_CHECK(MyStringView(flat) == MyStringView(model.data(), model.size()));
+    std::string chunks;
+    rope.for_each_chunk([&chunks](const MyStringView chunk) { chunks.append(chunk.data(), chunk.size()); });
+    BENCH_CHECK(chunks == model);
+    if (model.empty()) { return; }
+    for (int i = 0; i < 64; i++) {
+        const size_t index = random.below(model.size());
+        BENCH_CHECK(rope[index] == model[index]);
+    }
+    BENCH_CHECK(rope[0] == model.front() && rope[model.size() - 1] == model.back());
+    bool thrown = false;
+    try { (void)rope.at(model.size()); }
+    catch (const std::out_of_range&) { thrown = true; }
+    BENCH_CHECK(thrown);
+
+    // substr 的结果本身也是 rope，同样逐项检查
+    const size_t pos = random.below(model.size() + 1);
+    const size_t count = random.below(2) == 0 ? MyRope::npos : random.below(model.size() + 1);
+    const MyRope part = rope.substr(pos, count);
+    const std::string expected = model.substr(pos, count);
+    BENCH_CHECK(part.size() == expected.size());
+    const MyString part_flat = part.flatten();
+    BENCH_CHECK(MyStringView(part_flat) == MyStringView(expected.data(), expected.size()));
+    if (!expected.empty()) {
+        const size_t index = random.below(expected.size());
+        BENCH_CHECK(part[index] == expected[index]);
+    }
+}
+
+void test_random(const size_t rounds) {
+    bench::Random random;
+    MyRope rope;
+    std::string model;
+    for (size_t round = 0; round < rounds; round++) {
+        const std::string text = random_text(random, random.below(8) == 0 ? random.below(600) : random.below(24));
+        switch (random.below(9)) {
+            case 0: rope += text.c_str(); model += text; break;
+            case 1: rope.append(MyStringView(text.data(), text.size())); model += text; break;
+            case 2: rope += MyString(text.c_str()); model += text; break;
+            case 3: rope += 'x'; model += 'x'; break;
+            case 4: rope = MyRope(MyStringView(text.data(), text.size())) + rope; model = text + model; break;
+            case 5: rope += rope; model += model; break;
+            case 6: rope = rope + rope; model = model + model; break;
+            case 7: {
+                // 复制后修改副本，原 rope 共享的节点不能被改写
+                const MyRope before = rope;
+                const std::string before_model = model;
+                rope += text.c_str();
+                model += text;
+                check(before, before_model, random);
+                break;
+            }
+            default:
+                rope.rebalance();
+                BENCH_CHECK(rope.depth() <= 48);
+                break;
+        }
+        if (model.size() > MAX_LENGTH) {
+            const size_t pos = random.below(model.size() / 2);
+            rope = rope.substr(pos, MAX_LENGTH / 2);
+            model = model.substr(pos, MAX_LENGTH / 2);
+        }
+        check(rope, model, random);
+    }
+}
+
+// 反复前插让树向左倾斜，超过最大深度时自动重建
+void test_deep_prepend() {
+    bench::Random random;
+    MyRope rope;
+    std::string model;
+    for (int i = 0; i < 3000; i++) {
+        const std::string text = random_text(random, 130 + random.below(8));
+        rope = MyRope(MyStringView(text.data(), text.size())) + rope;
+        model = text + model;
+    }
+    BENCH_CHECK(rope.depth() <= 48);
+    check(rope, model, random);
+    rope.rebalance();
+    check(rope, model, random);
+    const MyRope doubled = rope + rope;
+    check(doubled, model + model, random);
+}
+
+int main(const int argc, char** argv) {
+    test_random(bench::arg(argc, argv, 1, 3000));
+    test_deep_prepend();
+    std::puts("ok");
+    return 0;
+}
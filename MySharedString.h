@@ -0,0 +1,167 @@
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include "MyAllocator.h"
+#include "MyString.h"
+#include "MyStringView.h"
+
+// 写时复制的字符串：复制只增加引用计数（原子操作，可以把副本交给其他线程），与其他对象共享同一块缓冲区；
+// 修改前若缓冲区被共享，先复制出独占的一份。适合在多层调用和容器之间传递的大块只读字符串，
+// 复制数 MB 的内容也是 O(1)。与标准库容器一样，同一个对象不能在多个线程中同时修改
+template<class Alloc = MyAllocator<char>>
+class MyBasicSharedString {
+private:
+    static constexpr int MULTIPLE = 2;
+
+    // 缓冲区头部，字符紧跟在后面，总是以空字符结尾
+    struct Rep {
+        std::atomic<size_t> refs;
+        size_t length;
+        size_t capacity;
+
+        char* chars() { return reinterpret_cast<char*>(this + 1); }
+    };
+    using RepAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Rep>;
+    using RepTraits = std::allocator_traits<RepAlloc>;
+
+    [[no_unique_address]] RepAlloc rep_alloc;
+    Rep* rep = nullptr;  // 空字符串不申请缓冲区
+
+    // 按 Rep 的大小为单位申请，保证对齐
+    static size_t units_for(const size_t capacity) { return 1 + (capacity + sizeof(Rep)) / sizeof(Rep); }
+
+    Rep* new_rep(const size_t capacity) {
+        Rep* result = RepTraits::allocate(rep_alloc, units_for(capacity));
+        ::new (static_cast<void*>(result)) Rep{{1}, 0, capacity};
+        return result;
+    }
+    void release() {
+        if (rep != nullptr && rep->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            const size_t units = units_for(rep->capacity);
+            rep->~Rep();
+            RepTraits::deallocate(rep_alloc, rep, units);
+        }
+        rep = nullptr;
+    }
+    void init_copy(const char* source, const size_t length) {
+        if (length == 0) { return; }
+        rep = new_rep(length);
+        memcpy(rep->chars(), source, length);
+        rep->chars()[length] = '\0';
+        rep->length = length;
+    }
+
+    // 修改前调用：保证缓冲区独占且至少能容纳 capacity 个字符，返回字符起点
+    char* make_unique(const size_t capacity) {
+        if (rep != nullptr && rep->refs.load(std::memory_order_acquire) == 1 && rep->capacity >= capacity) {
+            return rep->chars();
+        }
+        const size_t length = size();
+        const size_t grown = length * MULTIPLE;
+        Rep* fresh = new_rep(capacity > grown ? capacity : grown);
+        if (length > 0) { memcpy(fresh->chars(), rep->chars(), length); }
+        fresh->chars()[length] = '\0';
+        fresh->length = length;
+        release();
+        rep = fresh;
+        return rep->chars();
+    }
+
+public:
+    MyBasicSharedString() = default;
+    explicit MyBasicSharedString(const Alloc& alloc) : rep_alloc(alloc) {}
+    explicit MyBasicSharedString(const MyStringView other, const Alloc& alloc = Alloc()) : rep_alloc(alloc) {
+        init_copy(other.data(), other.size());
+    }
+    explicit MyBasicSharedString(const char* other, const Alloc& alloc = Alloc()) : rep_alloc(alloc) {
+        const MyStringView view(other);
+        init_copy(view.data(), view.size());
+    }
+    MyBasicSharedString(const MyBasicSharedString& other) : rep_alloc(other.rep_alloc), rep(other.rep) {
+        if (rep != nullptr) { rep->refs.fetch_add(1, std::memory_order_relaxed); }
+    }
+    MyBasicSharedString(MyBasicSharedString&& other) noexcept : rep_alloc(std::move(other.rep_alloc)), rep(other.rep) {
+        other.rep = nullptr;
+    }
+    ~MyBasicSharedString() { release(); }
+
+    MyBasicSharedString& operator=(MyBasicSharedString other) {
+        std::swap(rep_alloc, other.rep_alloc);
+        std::swap(rep, other.rep);
+        return *this;
+    }
+    MyBasicSharedString& operator=(const MyStringView other) {
+        return *this = MyBasicSharedString(other, Alloc(rep_alloc));
+    }
+
+    [[nodiscard]] size_t size() const { return rep == nullptr ? 0 : rep->length; }
+    [[nodiscard]] bool is_empty() const { return size() == 0; }
+    [[nodiscard]] size_t str_capacity() const { return rep == nullptr ? 0 : rep->capacity; }
+    // 共享同一缓冲区的对象个数，空字符串为 0
+    [[nodiscard]] size_t use_count() const { return rep == nullptr ? 0 : rep->refs.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] const char* c_str() const { return rep == nullptr ? "" : rep->chars(); }
+    [[nodiscard]] const char* data() const { return c_str(); }
+    operator MyStringView() const { return MyStringView(c_str(), size()); }
+    [[nodiscard]] MyBasicString<Alloc> str() const {
+        return MyBasicString<Alloc>(MyStringView(*this), Alloc(rep_alloc));
+    }
+
+    char operator[](const size_t index) const { return c_str()[index]; }
+    [[nodiscard]] char at(const size_t index) const {
+        if (index >= size()) { throw std::out_of_range("string index out of range"); }
+        return c_str()[index];
+    }
+
+    // 以下操作会修改内容，缓冲区被共享时先复制
+    void set(const size_t index, const char ch) {
+        if (index >= size()) { throw std::out_of_range("string index out of range"); }
+        make_unique(size())[index] = ch;
+    }
+    // 独占后的可写指针，长度不变
+    char* mutable_data() { return rep == nullptr ? nullptr : make_unique(size()); }
+    void reserve(const size_t capacity) {
+        if (capacity > str_capacity()) { make_unique(capacity); }
+    }
+    MyBasicSharedString& append(const MyStringView other) {
+        if (other.is_empty()) { return *this; }
+        const size_t length = size();
+        const bool in_place = rep != nullptr && rep->refs.load(std::memory_order_acquire) == 1 &&
+                              length + other.size() <= rep->capacity;
+        if (in_place) {
+            memcpy(rep->chars() + length, other.data(), other.size());  // other 指向自身时也不重叠
+        }
+        else {
+            // other 可能指向旧缓冲区，先复制到新缓冲区再释放旧的
+            const size_t grown = length * MULTIPLE;
+            const size_t capacity = length + other.size() > grown ? length + other.size() : grown;
+            Rep* fresh = new_rep(capacity);
+            if (length > 0) { memcpy(fresh->chars(), rep->chars(), length); }
+            memcpy(fresh->chars() + length, other.data(), other.size());
+            release();
+            rep = fresh;
+        }
+        rep->length = length + other.size();
+        rep->chars()[rep->length] = '\0';
+        return *this;
+    }
+    MyBasicSharedString& operator+=(const MyStringView other) { return append(other); }
+    MyBasicSharedString& operator+=(const char ch) { return append(MyStringView(&ch, 1)); }
+    void clear() {
+        if (rep == nullptr) { return; }
+        if (rep->refs.load(std::memory_order_acquire) == 1) {
+            rep->length = 0;
+            rep->chars()[0] = '\0';
+        }
+        else { release(); }
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const MyBasicSharedString& str) {
+        return out << MyStringView(str);
+    }
+};
+
+using MySharedString = MyBasicSharedString<>;
@@ -0,0 +1,123 @@
+// MySharedString 的测试：复制后修改其中一份，另一份保持不变；多个线程同时复制和销毁同一个对象。
+// 应当在 AddressSanitizer 和 ThreadSanitizer 下都没有报告
+// 用法：MySharedStringTest [每个线程的轮数]，默认 100000
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Bench.h"
+#include "MySharedString.h"
+
+static constexpr int THREADS = 4;
+
+bool equals(const MySharedString& str, const std::string& expected) {
+    return MyStringView(str) == MyStringView(expected.data(), expected.size()) && str.c_str()[str.size()] == '\0';
+}
+
+// 每种修改操作都先复制，修改副本后比较两份的内容和引用计数
+void test_copy_on_write() {
+    const std::string text(100, 'a');
+    const MySharedString original(text.c_str());
+    BENCH_CHECK(original.use_count() == 1);
+
+    MySharedString copy = original;
+    BENCH_CHECK(copy.data() == original.data() && original.use_count() == 2);
+    copy.set(0, 'b');
+    BENCH_CHECK(copy.data() != original.data() && original.use_count() == 1 && copy.use_count() == 1);
+    BENCH_CHECK(equals(original, text) && equals(copy, "b" + text.substr(1)));
+
+    copy = original;
+    copy.mutable_data()[99] = 'z';
+    BENCH_CHECK(equals(original, text) && equals(copy, text.substr(0, 99) + "z"));
+
+    copy = original;
+    copy += "tail";
+    copy += '!';
+    BENCH_CHECK(equals(original, text) && equals(copy, text + "tail!"));
+
+    copy = original;
+    copy.reserve(1000);
+    BENCH_CHECK(copy.str_capacity() >= 1000 && equals(copy, text) && original.use_count() == 1);
+
+    copy = original;
+    copy.clear();
+    BENCH_CHECK(copy.is_empty() && equals(original, text) && original.use_count() == 1);
+
+    copy = original;
+    copy = MyStringView("other");
+    BENCH_CHECK(equals(copy, "other") && equals(original, text));
+
+    // 追加自身：共享时和独占时都要先读完旧内容
+    copy = original;
+    copy.append(copy);
+    BENCH_CHECK(equals(copy, text + text) && equals(original, text));
+    copy.reserve(copy.size() * 4);
+    copy.append(copy);
+    BENCH_CHECK(equals(copy, text + text + text + text));
+
+    // 独占时原地修改，不重新申请
+    MySharedString unique(text.c_str());
+    const char* before = unique.data();
+    unique.set(1, 'q');
+    BENCH_CHECK(unique.data() == before);
+
+    bool thrown = false;
+    try { copy.set(copy.size(), 'x'); }
+    catch (const std::out_of_range&) { thrown = true; }
+    BENCH_CHECK(thrown);
+
+    // 空字符串没有缓冲区，复制和修改都照常工作
+    MySharedString empty;
+    MySharedString empty_copy = empty;
+    BENCH_CHECK(empty.use_count() == 0 && equals(empty_copy, ""));
+    empty_copy += "x";
+    BENCH_CHECK(equals(empty_copy, "x") && equals(empty, ""));
+}
+
+// 所有线程同时复制同一个对象，读取、修改并销毁各自的副本
+void test_concurrent_copies(const size_t rounds) {
+    const std::string text(1000, 's');
+    const MySharedString shared(text.c_str());
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&shared, &text, rounds, t] {
+            for (size_t round = 0; round < rounds; round++) {
+                MySharedString copy = shared;
+                BENCH_CHECK(copy.size() == text.size() && copy[round % text.size()] == 's');
+                if (round % 16 == 0) {
+                    copy.set(0, static_cast<char>('0' + t));
+                    BENCH_CHECK(copy[0] == '0' + t && shared[0] == 's');
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) { thread.join(); }
+    BENCH_CHECK(shared.use_count() == 1 && equals(shared, text));
+}
+
+// 最后一个引用可能在任意线程中释放，缓冲区只释放一次
+void test_concurrent_release(const size_t rounds) {
+    for (size_t round = 0; round < rounds / 100; round++) {
+        MySharedString original("released in some thread");
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++) {
+            threads.emplace_back([copy = original]() mutable {
+                BENCH_CHECK(equals(copy, "released in some thread"));
+                MySharedString moved = std::move(copy);
+            });
+        }
+        original = MySharedString();
+        for (std::thread& thread : threads) { thread.join(); }
+    }
+}
+
+int main(const int argc, char** argv) {
+    const size_t rounds = bench::arg(argc, argv, 1, 100000);
+    test_copy_on_write();
+    test_concurrent_copies(rounds);
+    test_concurrent_release(rounds);
+    std::puts("ok");
+    return 0;
+}
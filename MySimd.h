@@ -0,0 +1,31 @@
+#pragma once
+
+// 运行时指令集检测，供各个向量化的批量算法按 CPU 选择实现。
+// 只在 GCC / Clang 的 x86 目标上检测，其他平台一律视为 SCALAR
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MY_SIMD_X86 1
+#else
+#define MY_SIMD_X86 0
+#endif
+
+namespace my_simd {
+
+enum class Isa { SCALAR, SSE2, AVX2, AVX512 };
+
+inline Isa detect() {
+#if MY_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) { return Isa::AVX512; }
+    if (__builtin_cpu_supports("avx2")) { return Isa::AVX2; }
+    if (__builtin_cpu_supports("sse2")) { return Isa::SSE2; }
+#endif
+    return Isa::SCALAR;
+}
+
+// 只检测一次
+inline Isa isa() {
+    static const Isa result = detect();
+    return result;
+}
+
+}  // namespace my_simd
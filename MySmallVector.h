@@ -0,0 +1,250 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "MyAllocator.h"
+#include "MyVector.h"
+#include "VectorOps.h"
+
+
+// 前 N 个元素存放在对象内部，超过 N 时才向分配器申请堆内存，接口与 MyVector 相同
+template<class T, size_t N, class Alloc = MyAllocator<T>>
+class MySmallVector : public vector_detail::VectorOps<MySmallVector<T, N, Alloc>, T, Alloc> {
+    static_assert(N > 0, "inline capacity must be positive");
+
+private:
+    using Base = vector_detail::VectorOps<MySmallVector, T, Alloc>;
+    friend Base;
+    using Traits = std::allocator_traits<Alloc>;
+    using Base::relocate;
+    using Base::construct_range;
+    static constexpr bool REMAPPABLE = false;  // 内联缓冲区不能交给分配器重映射
+    [[no_unique_address]] Alloc alloc;
+    size_t size_{};
+    size_t capacity_{N};
+    T* ptr;
+    alignas(T) std::byte buffer[N * sizeof(T)];
+
+    T* inline_ptr() { return reinterpret_cast<T*>(buffer); }
+
+    void destroy_all() {
+        for (size_t i = 0; i < size_; i++) { Traits::destroy(alloc, ptr + i); }
+        size_ = 0;
+    }
+    void release() {
+        destroy_all();
+        if (!is_small()) { Traits::deallocate(alloc, ptr, capacity_); }
+        ptr = inline_ptr();
+        capacity_ = N;
+    }
+
+    size_t grow_capacity(const size_t add_capacity) const {
+        return capacity_ + (add_capacity > capacity_ ? add_capacity : capacity_);
+    }
+
+    // 释放旧的堆缓冲区并换成 new_ptr，调用前元素必须已经搬走
+    void adopt(T* new_ptr, const size_t new_capacity) {
+        if (!is_small()) { Traits::deallocate(alloc, ptr, capacity_); }
+        ptr = new_ptr;
+        capacity_ = new_capacity;
+    }
+
+    void reallocate(const size_t new_capacity) {
+        T* new_ptr = Traits::allocate(alloc, new_capacity);
+        try { relocate(new_ptr, ptr, size_); }
+        catch (...) {
+            Traits::deallocate(alloc, new_ptr, new_capacity);
+            throw;
+        }
+        adopt(new_ptr, new_capacity);
+    }
+
+    // 接管 other 的元素：堆上的缓冲区直接转移指针，内联的元素逐个搬过来
+    void steal(MySmallVector& other) {
+        if (other.is_small()) {
+            relocate(ptr, other.ptr, other.size_);
+            size_ = other.size_;
+        }
+        else {
+            ptr = other.ptr;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.ptr = other.inline_ptr();
+            other.capacity_ = N;
+        }
+        other.size_ = 0;
+    }
+
+public:
+    using VectorIterator = typename MyVector<T, Alloc>::VectorIterator;
+
+    MySmallVector() : ptr(inline_ptr()) {}
+    explicit MySmallVector(const Alloc& alloc_) : alloc(alloc_), ptr(inline_ptr()) {}
+    explicit MySmallVector(const size_t num, const T& value = T(), const Alloc& alloc_ = Alloc())
+        : alloc(alloc_), ptr(inline_ptr()) {
+        if (num > N) { reallocate(num); }
+        for (; size_ < num; size_++) { Traits::construct(alloc, ptr + size_, value); }
+    }
+    template<class InputIt> requires (!std::is_integral_v<InputIt>)
+    MySmallVector(InputIt first, InputIt last, const Alloc& alloc_ = Alloc()) : alloc(alloc_), ptr(inline_ptr()) {
+        this->append(first, last);
+    }
+    MySmallVector(const MySmallVector& other)
+        : alloc(Traits::select_on_container_copy_construction(other.alloc)), ptr(inline_ptr()) {
+        if (other.size_ > N) { reallocate(other.size_); }
+        construct_range(ptr, other.ptr, other.size_);
+        size_ = other.size_;
+    }
+    MySmallVector(MySmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : alloc(std::move(other.alloc)), ptr(inline_ptr()) {
+        steal(other);
+    }
+
+    MySmallVector& move(MySmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this == &other) { return *this; }
+        release();
+        alloc = other.alloc;
+        steal(other);
+        return *this;
+    }
+
+    ~MySmallVector() { release(); }
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+    [[nodiscard]] bool is_empty() const { return size_ == 0; }
+    [[nodiscard]] bool is_small() const { return ptr == reinterpret_cast<const T*>(buffer); }
+
+    template<class... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ < capacity_) {
+            Traits::construct(alloc, ptr + size_, std::forward<Args>(args)...);
+            return ptr[size_++];
+        }
+        // 先在新缓冲区中构造新元素，这样参数引用本容器中的元素时依然有效
+        const size_t new_capacity = grow_capacity(capacity_);
+        T* new_ptr = Traits::allocate(alloc, new_capacity);
+        try { Traits::construct(alloc, new_ptr + size_, std::forward<Args>(args)...); }
+        catch (...) {
+            Traits::deallocate(alloc, new_ptr, new_capacity);
+            throw;
+        }
+        try { relocate(new_ptr, ptr, size_); }
+        catch (...) {
+            Traits::destroy(alloc, new_ptr + size_);
+            Traits::deallocate(alloc, new_ptr, new_capacity);
+            throw;
+        }
+        adopt(new_ptr, new_capacity);
+        return ptr[size_++];
+    }
+    template<class... Args>
+    T& emplace(const size_t index, Args&&... args) {
+        if (index >= size_) { return emplace_back(std::forward<Args>(args)...); }
+        T temp(std::forward<Args>(args)...);  // 先构造，参数可能引用即将被移动的元素
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (size_ >= capacity_) { reallocate(grow_capacity(capacity_)); }
+            memmove(ptr + index + 1, ptr + index, (size_ - index) * sizeof(T));
+            memcpy(ptr + index, &temp, sizeof(T));
+            size_++;
+        }
+        else {
+            emplace_back(std::move(ptr[size_ - 1]));
+            for (size_t i = size_ - 2; i > index; i--) { ptr[i] = std::move(ptr[i - 1]); }
+            ptr[index] = std::move(temp);
+        }
+        return ptr[index];
+    }
+
+    MySmallVector& push_back(const T& data) {
+        emplace_back(data);
+        return *this;
+    }
+    MySmallVector& push_back(T&& data) {
+        emplace_back(std::move(data));
+        return *this;
+    }
+    void pop_back() {
+        if (size_ == 0) return;
+        size_--;
+        Traits::destroy(alloc, ptr + size_);
+    }
+    MySmallVector& push_front(const T& data) {
+        emplace(0, data);
+        return *this;
+    }
+    MySmallVector& push_front(T&& data) {
+        emplace(0, std::move(data));
+        return *this;
+    }
+    void pop_front() {
+        if (size_ == 0) return;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            memmove(ptr, ptr + 1, (size_ - 1) * sizeof(T));
+            size_--;
+        }
+        else {
+            for (size_t i = 0; i + 1 < size_; i++) { ptr[i] = std::move(ptr[i + 1]); }
+            pop_back();
+        }
+    }
+    void swap(int index1, int index2) {
+        if (index1 != index2) {
+            T temp = std::move(ptr[index2]);
+            ptr[index2] = std::move(ptr[index1]);
+            ptr[index1] = std::move(temp);
+        }
+    }
+    void insert(int index, const T& data) { emplace(index, data); }
+    void insert(int index, T&& data) { emplace(index, std::move(data)); }
+    // 区间插入、erase、resize、assign 见 VectorOps.h
+    using Base::insert;
+
+    T& front() { return *ptr; }
+    const T& front() const { return *ptr; }
+    T& back() { return *(ptr + size_ - 1); }
+    const T& back() const { return *(ptr + size_ - 1); }
+
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    void clear() { destroy_all(); }
+    void reserve(const size_t add_capacity) { reallocate(grow_capacity(add_capacity)); }
+
+    MySmallVector& operator=(const MySmallVector& other) {
+        if (this != &other) {
+            destroy_all();
+            if (other.size_ > capacity_) { reallocate(other.size_); }
+            construct_range(ptr, other.ptr, other.size_);
+            size_ = other.size_;
+        }
+        return *this;
+    }
+    MySmallVector& operator=(MySmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        return move(other);
+    }
+
+    // 把容量缩减到恰好容纳现有元素，元素不超过 N 个时搬回对象内部
+    void shrink_to_fit() {
+        if (is_small() || size_ == capacity_) return;
+        if (size_ > N) {
+            reallocate(size_);
+            return;
+        }
+        T* heap_ptr = ptr;
+        const size_t heap_capacity = capacity_;
+        relocate(inline_ptr(), heap_ptr, size_);
+        ptr = inline_ptr();
+        capacity_ = N;
+        Traits::deallocate(alloc, heap_ptr, heap_capacity);
+    }
+
+    Alloc get_allocator() const { return alloc; }
+
+    VectorIterator begin() const { return VectorIterator(ptr); }
+    VectorIterator end() const { return VectorIterator(ptr + size_); }
+
+    // Subscript operator
+    T& operator[](const size_t index) const { return ptr[index]; }
+    T* data() const { return ptr; }
+};
@@ -0,0 +1,102 @@
+// MySmallVector 的测试：内联缓冲区在 N 与 N + 1 个元素之间的溢出边界，内联和堆上两种状态下的复制与移动
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include "Bench.h"
+#include "MySmallVector.h"
+#include "MyString.h"
+#include "MyVector.h"
+
+static constexpr size_t N = 8;
+
+template<class T>
+T make(const int i) {
+    if constexpr (std::is_same_v<T, MyString>) { return MyString(std::to_string(i).c_str()); }
+    else { return T(i); }
+}
+
+// 内容为 make(0) .. make(num - 1)
+template<class T>
+void check_values(const MySmallVector<T, N>& vector, const size_t num) {
+    BENCH_CHECK(vector.size() == num);
+    for (size_t i = 0; i < num; i++) { BENCH_CHECK(vector[i] == make<T>(static_cast<int>(i))); }
+    size_t count = 0;
+    for (auto it = vector.begin(); it != vector.end(); ++it) { BENCH_CHECK(*it == make<T>(static_cast<int>(count++))); }
+    BENCH_CHECK(count == num);
+}
+
+template<class T>
+MySmallVector<T, N> filled(const size_t num) {
+    MySmallVector<T, N> vector;
+    for (size_t i = 0; i < num; i++) { vector.push_back(make<T>(static_cast<int>(i))); }
+    return vector;
+}
+
+// 第 N 个元素仍在对象内部，第 N + 1 个元素触发溢出到堆上
+template<class T>
+void test_spill_boundary() {
+    BENCH_CHECK((MySmallVector<T, N>().capacity() == N));
+    MySmallVector<T, N> vector = filled<T>(N);
+    BENCH_CHECK(vector.is_small() && vector.capacity() == N);
+    check_values(vector, N);
+    vector.push_back(make<T>(static_cast<int>(N)));
+    BENCH_CHECK(!vector.is_small() && vector.capacity() > N);
+    check_values(vector, N + 1);
+
+    // 区间追加恰好填满内联缓冲区，再在中间 emplace 一个元素跨过边界
+    MySmallVector<T, N> ranged;
+    const MySmallVector<T, N> source = filled<T>(N + 1);
+    ranged.append(source.begin(), source.begin() + N / 2);
+    ranged.append(source.begin() + N / 2 + 1, source.end());
+    BENCH_CHECK(ranged.is_small() && ranged.size() == N);
+    ranged.emplace(N / 2, make<T>(static_cast<int>(N / 2)));
+    BENCH_CHECK(!ranged.is_small());
+    check_values(ranged, N + 1);
+}
+
+// 复制与移动内联和已溢出的实例，源对象在复制后不受影响，移动后为空
+template<class T>
+void test_copy_move() {
+    for (const size_t num : {N, N + 1}) {
+        MySmallVector<T, N> original = filled<T>(num);
+        const bool small = num <= N;
+        BENCH_CHECK(original.is_small() == small);
+
+        MySmallVector<T, N> copy(original);
+        BENCH_CHECK(copy.is_small() == small);
+        check_values(copy, num);
+        check_values(original, num);
+        copy.push_back(make<T>(-1));
+        check_values(original, num);
+
+        MySmallVector<T, N> assigned = filled<T>(3);
+        assigned = original;
+        check_values(assigned, num);
+        MySmallVector<T, N> shrunk = filled<T>(N + 5);
+        shrunk = original;
+        check_values(shrunk, num);
+
+        MySmallVector<T, N> moved(std::move(original));
+        check_values(moved, num);
+        BENCH_CHECK(original.size() == 0);
+        MySmallVector<T, N> move_assigned = filled<T>(N + 3);
+        move_assigned = std::move(moved);
+        check_values(move_assigned, num);
+        BENCH_CHECK(moved.size() == 0);
+        // 移走后的实例仍可继续使用
+        moved = filled<T>(1);
+        check_values(moved, 1);
+    }
+}
+
+int main() {
+    // 与 MyVector 共用迭代器类型
+    static_assert(std::is_same_v<MySmallVector<int, N>::VectorIterator, MyVector<int>::VectorIterator>);
+    static_assert(std::is_same_v<decltype(MySmallVector<MyString, N>().begin()), MyVector<MyString>::VectorIterator>);
+    test_spill_boundary<int>();
+    test_spill_boundary<MyString>();
+    test_copy_move<int>();
+    test_copy_move<MyString>();
+    std::puts("ok");
+    return 0;
+}
@@ -1,7 +1,15 @@
 #pragma once
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include "MyVector.h"
-#include "MyHeap.h"
-#include "MyStack.h"
+#include "IntroSort.h"
+#include "ParallelSort.h"
+#include "RadixSort.h"
+#include "SortNetwork.h"
 
 enum SortType {
     bubble = 1,
@@ -12,49 +20,67 @@ enum SortType {
     heap = 6,
     merge = 7,
     radix = 8,
+    parallel = 9,
 };
 
 class MySort {
 private:
     int type;
-    static constexpr int SMALL_QUICK = 6;
+    size_t threads;  // parallel 使用的线程数
     static constexpr int SHELL_GAP[14] = {1, 9, 34, 182, 836, 4025, 19001, 90358,
         428481, 2034035, 9651787, 45806244, 217378076, 1031612713};
-    template<typename T>
-    static void bubble(MyVector<T>& data) {
+    // 比较是否就是 T 的默认 >，与 intro_sort::DEFAULT_LESS 对应，radix 据此按降序排序
+    template<typename T, typename Less>
+    static constexpr bool DEFAULT_GREATER = std::is_same_v<Less, std::greater<>> || std::is_same_v<Less, std::greater<T>>;
+
+    // 按 less 比较 proj(元素)，用于带投影的排序
+    template<typename Less, typename Proj>
+    struct ProjectedLess {
+        [[no_unique_address]] Less less;
+        [[no_unique_address]] Proj proj;
+
+        template<typename T>
+        bool operator()(const T& lhs, const T& rhs) const {
+            return std::invoke(less, std::invoke(proj, lhs), std::invoke(proj, rhs));
+        }
+    };
+
+    // 以下算法都按元素的比较 comp 升序排序，comp(a, b) 为 true 表示 a 应排在 b 前面
+    template<typename T, typename Alloc, typename Compare>
+    static void bubble(MyVector<T, Alloc>& data, Compare& comp) {
         const size_t size = data.size();
         for (int i = 0; i < size; i++) {
             for (int j = 0; j < size - i - 1; j++) {
-                if (data[j] > data[j + 1]) { data.swap(j, j + 1); }
+                if (comp(data[j + 1], data[j])) { data.swap(j, j + 1); }
             }
         }
     }
 
-    template<typename T>
-    static void choose(MyVector<T>& data) {
+    template<typename T, typename Alloc, typename Compare>
+    static void choose(MyVector<T, Alloc>& data, Compare& comp) {
         const size_t size = data.size();
         for (int i = 0; i < size; i++) {
             size_t minIndex = i;
             for (int j = i + 1; j < size; j++) {
-                if (data[j] < data[minIndex]) { minIndex = j; }
+                if (comp(data[j], data[minIndex])) { minIndex = j; }
             }
             data.swap(i, minIndex);
         }
     }
 
-    template<typename T>
-    static void insert(MyVector<T>& data) {
+    template<typename T, typename Alloc, typename Compare>
+    static void insert(MyVector<T, Alloc>& data, Compare& comp) {
         const size_t size = data.size();
-        for (int i = 0; i < size - 1; ++i) {
+        for (int i = 0; i + 1 < size; ++i) {
             T key = data[i + 1];
             int j = i;
-            for (; j >= 0 && data[j] > key; --j) { data[j + 1] = data[j]; }
+            for (; j >= 0 && comp(key, data[j]); --j) { data[j + 1] = data[j]; }
             data[j + 1] = key;
         }
     }
 
-    template<typename T>
-    static void shell(MyVector<T>& data) {
+    template<typename T, typename Alloc, typename Compare>
+    static void shell(MyVector<T, Alloc>& data, Compare& comp) {
         const int size = data.size();
         int gap_index = 0;
         for (int i = 0; i < 14; i++) {
@@ -66,70 +92,52 @@ private:
             for (int i = 0; i < size - gap; i++) {
                 T key = data[i + gap];
                 int j = i;
-                for (; j >= 0 && data[j] > key; j -= gap) { data[j + gap] = data[j]; }
+                for (; j >= 0 && comp(key, data[j]); j -= gap) { data[j + gap] = data[j]; }
                 data[j + gap] = key;
             }
         }
     }
 
-    template<typename T>
-    static void quick(MyVector<T>& data) {
-        struct pair {
-            int first;
-            int last;
-        };
-        MyStack<pair> border;
-        border.push({0, static_cast<int>(data.size() - 1)});
-        while (!border.empty()) {
-            int left = border.top().first;
-            int right = border.top().last;
-            if (right - left <= SMALL_QUICK) {
-                for (int i = left; i < right; ++i) {
-                    T key = data[i + 1];
-                    int j = i;
-                    for (; j >= left && data[j] > key; --j) { data[j + 1] = data[j];}
-                    data[j + 1] = key;
-                }
-                border.pop();
-                continue;
-            }
+    // pdqsort 风格的内省排序，见 IntroSort.h
+    template<typename T, typename Alloc, typename Compare>
+    static void quick(MyVector<T, Alloc>& data, Compare& comp) {
+        intro_sort::sort(data.data(), data.data() + data.size(), comp);
+    }
 
-            const T key = data[left];
-            while (left < right){
-                while (left < right && data[right] >= key) { --right; }
-                while (left < right && data[left] <= key) { ++left; }
-                data.swap(left, right);
-            }
-            const int mid = left;
-            left = border.top().first;
-            right = border.top().last;
-            data.swap(left, mid);
-
-            border.pop();
-            border.push({mid + 1, right});
-            border.push({left, mid - 1});
-        }
+    // 多线程样本排序，见 ParallelSort.h。数据较少时退化为单线程的 quick
+    template<typename T, typename Alloc, typename Compare>
+    void parallel(MyVector<T, Alloc>& data, Compare& comp) const {
+        parallel_sort::sort(data.data(), data.data() + data.size(), comp, threads, data.get_allocator());
     }
 
-    template<typename T>
-    static void heap(MyVector<T>& data){
-        sort_Vector(data);
+    template<typename T, typename Alloc, typename Compare>
+    static void heap(MyVector<T, Alloc>& data, Compare& comp) {
+        intro_sort::heap_sort(data.data(), data.data() + data.size(), comp);
     }
 
-    template<typename T>
-    static void merge(MyVector<T>& data) {
+    // 相等时取左侧的元素，排序是稳定的
+    template<typename T, typename Alloc, typename Compare>
+    static void merge(MyVector<T, Alloc>& data, Compare& comp) {
         const int size = static_cast<int>(data.size());
         int gap = 1;
+        // 32 / 64 位整数和浮点数按默认顺序排序时，先用排序网络排好每 MAX_SIZE 个元素，再从这个长度开始归并
+        if constexpr (sort_network::NetworkKey<T> && std::is_same_v<Compare, std::less<T>>) {
+            constexpr int BLOCK = sort_network::MAX_SIZE;
+            for (int left = 0; left < size; left += BLOCK) {
+                sort_network::sort(data.data() + left, static_cast<size_t>(std::min(BLOCK, size - left)));
+            }
+            gap = BLOCK;
+        }
         while(gap < size) {
             int left = 0;
-            MyVector<T> temp(size, 0);
+            MyVector<T, Alloc> temp(size, T(), data.get_allocator());
             while (left + gap < size) {
                 const int mid = left + gap;
                 const int right = std::min(mid + gap, size);
                 int merge1 = left;
                 int merge2 = mid;
                 for(int i = left; i < right; ++i ) {
-                    if (merge2 >= right || (merge1 < mid && data[merge1] < data[merge2])) {
+                    if (merge2 >= right || (merge1 < mid && !comp(data[merge2], data[merge1]))) {
                         temp[i] = data[merge1];
                         merge1++;
                     }
@@ -149,67 +157,119 @@ private:
         }
     }
 
-    static void radix(MyVector<int>& data) {
-        int multi = 1;
-        while (true) {
-            MyVector<int> bucket[10];
-            for (const auto& i : data) {
-                bucket[i / multi % 10].push_back(i);
-            }
-            if (bucket[0].size() == data.size()) {
-                data.move(bucket[0]);
-                break;
-            }
-            int index = 0;
-            for (const auto& i : bucket) {
-                for (const auto& j : i) {
-                    data[index++] = j;
-                }
-            }
-            multi *= 10;
+    // 基数排序只支持整数或浮点数键，按默认的 less 升序或按 std::greater 降序，键由 proj 得到，见 RadixSort.h。
+    // 降序时对 key_bits 逐位取反再升序排序，键相等的元素仍保持原来的顺序。
+    // 算法在运行时由 type 选择，其他比较在编译期无法排除，只能抛出异常
+    template<typename T, typename Alloc, typename Less, typename Proj>
+    static void radix(MyVector<T, Alloc>& data, Less&, Proj& proj) {
+        using Key = std::remove_cvref_t<std::invoke_result_t<Proj&, const T&>>;
+        if constexpr (radix_sort::RadixKey<Key> && intro_sort::DEFAULT_LESS<Key, Less>) {
+            radix_sort::sort(data.data(), data.data() + data.size(),
+                             [&proj](const T& value) { return std::invoke(proj, value); }, data.get_allocator());
         }
+        else if constexpr (radix_sort::RadixKey<Key> && DEFAULT_GREATER<Key, Less>) {
+            using Bits = decltype(radix_sort::key_bits(Key()));
+            radix_sort::sort(data.data(), data.data() + data.size(), [&proj](const T& value) {
+                return static_cast<Bits>(~radix_sort::key_bits(static_cast<Key>(std::invoke(proj, value))));
+            }, data.get_allocator());
+        }
+        else { throw std::invalid_argument("Invalid type for cardinality sort"); }
     }
 
-    template<typename T>
-    static void radix(MyVector<T>& data) {
-        throw std::invalid_argument("Invalid type for cardinality sort");
-    }
-
-public:
-    explicit MySort(const int _type = SortType::quick) : type(_type) {}
-    ~MySort() = default;
-
-    template<typename T>
-    void operator()(MyVector<T>& data) const{
+    template<typename T, typename Alloc, typename Compare>
+    void sort_with(MyVector<T, Alloc>& data, Compare comp) const {
         switch (type) {
             case SortType::bubble:
-                bubble(data);
+                bubble(data, comp);
             return;
             case SortType::choose:
-                choose(data);
+                choose(data, comp);
             return;
             case SortType::insert:
-                insert(data);
+                insert(data, comp);
             return;
             case SortType::shell:
-                shell(data);
+                shell(data, comp);
             return;
             case SortType::quick:
-                quick(data);
+                quick(data, comp);
             return;
             case SortType::heap:
-                heap(data);
+                heap(data, comp);
             return;
             case SortType::merge:
-                merge(data);
+                merge(data, comp);
             return;
-            case SortType::radix:
-                radix(data);
+            case SortType::parallel:
+                parallel(data, comp);
             return;
             default:
-                quick(data);
+                quick(data, comp);
+            return;
+        }
+    }
+
+public:
+    // _threads 为 0 时使用硬件支持的线程数，只对 SortType::parallel 有效
+    explicit MySort(const int _type = SortType::quick, const size_t _threads = 0)
+        : type(_type), threads(_threads != 0 ? _threads : std::thread::hardware_concurrency()) {}
+    ~MySort() = default;
+
+    // 按 less(proj(a), proj(b)) 排序，默认按元素的 < 升序。proj 可以是函数对象或成员指针，
+    // 例如 MySort()(people, std::greater<>(), &Person::age)。radix 只支持默认的 less 与 std::greater
+    template<typename T, typename Alloc, typename Less = std::less<>, typename Proj = std::identity>
+    void operator()(MyVector<T, Alloc>& data, Less less = Less(), Proj proj = Proj()) const {
+        if (type == SortType::radix) {
+            radix(data, less, proj);
             return;
         }
+        // 默认的比较统一为 std::less<T>，intro_sort 与 merge 据此启用排序网络
+        if constexpr (std::is_same_v<Proj, std::identity> && intro_sort::DEFAULT_LESS<T, Less>) {
+            sort_with(data, std::less<T>());
+        }
+        else if constexpr (std::is_same_v<Proj, std::identity>) { sort_with(data, less); }
+        else { sort_with(data, ProjectedLess<Less, Proj>{less, proj}); }
+    }
+
+    // 先装饰、再排序、最后还原（decorate-sort-undecorate）：对每个元素只计算一次 proj，与下标一起存入紧凑的数组，
+    // 按 type 指定的算法排序这个数组，再按下标沿置换环移动原来的元素，每个元素只移动一次。
+    // 比较时不重复计算键，也不访问原来的元素，适合键的计算代价高或元素很大的情形。键相等时保持原来的顺序
+    template<typename T, typename Alloc, typename Proj, typename Less = std::less<>>
+    void sort_by_cached_key(MyVector<T, Alloc>& data, Proj proj, Less less = Less()) const {
+        using Key = std::remove_cvref_t<std::invoke_result_t<Proj&, const T&>>;
+        struct Decorated {
+            Key key;
+            size_t index;
+        };
+        using DecoratedAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Decorated>;
+        const size_t size = data.size();
+        MyVector<Decorated, DecoratedAlloc> keys{DecoratedAlloc(data.get_allocator())};
+        keys.reserve(size);
+        for (size_t i = 0; i < size; i++) { keys.push_back(Decorated{std::invoke(proj, data[i]), i}); }
+
+        // radix 本身稳定；其他算法在键相等时比较下标
+        if (type == SortType::radix) { (*this)(keys, less, &Decorated::key); }
+        else {
+            (*this)(keys, [&less](const Decorated& lhs, const Decorated& rhs) {
+                if (less(lhs.key, rhs.key)) { return true; }
+                return !less(rhs.key, lhs.key) && lhs.index < rhs.index;
+            });
+        }
+
+        // 排序后第 i 个位置应放原来的第 keys[i].index 个元素，放好后把 index 改为 i 作为标记
+        for (size_t i = 0; i < size; i++) {
+            if (keys[i].index == i) { continue; }
+            T temp = std::move(data[i]);
+            size_t j = i;
+            while (keys[j].index != i) {
+                const size_t next = keys[j].index;
+                data[j] = std::move(data[next]);
+                keys[j].index = j;
+                j = next;
+            }
+            data[j] = std::move(temp);
+            keys[j].index = j;
+        }
     }
 };
 
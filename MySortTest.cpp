@@ -0,0 +1,344 @@
+// MySort 的测试：结果与 std::stable_sort 得到的顺序逐位对照。
+// 基数排序覆盖 float / double 的负数、-0.0 与 +0.0、无穷大和非规格化数，以及各种宽度的有符号整数；
+// 排序网络覆盖 2 到 32 个元素，即 8 / 16 / 32 三种大小的网络和 CPU 支持的每种寄存器宽度；
+// 全部九种 SortType 分别配合默认比较、std::greater、自定义比较、成员指针投影和 sort_by_cached_key
+// 用法：MySortTest [大数组的元素个数]，默认 100000
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "Bench.h"
+#include "MySort.h"
+#include "MyVector.h"
+#include "SortNetwork.h"
+
+// 值的大小顺序，相等时 -0.0 排在 +0.0 前面，与 radix_sort::key_bits 的顺序一致（不含 NaN）
+struct TotalLess {
+    template<class T>
+    bool operator()(const T lhs, const T rhs) const {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (lhs == rhs) { return std::signbit(lhs) && !std::signbit(rhs); }
+        }
+        return lhs < rhs;
+    }
+};
+
+// 逐字节相同，浮点数也区分 -0.0 与 +0.0
+template<class Actual, class T>
+bool same_bits(const Actual& actual, const std::vector<T>& expected) {
+    return actual.size() == expected.size() &&
+           (expected.empty() || memcmp(actual.data(), expected.data(), expected.size() * sizeof(T)) == 0);
+}
+
+// 一半取自少量特殊值，制造大量重复键；另一半是随机位模式（浮点数跳过 NaN）
+template<class T>
+T random_value(bench::Random& random) {
+    if constexpr (std::is_floating_point_v<T>) {
+        using Limits = std::numeric_limits<T>;
+        const T specials[] = {T(0), -T(0), T(1), T(-1), T(-2.5), Limits::infinity(), -Limits::infinity(),
+                              Limits::denorm_min(), -Limits::denorm_min(), Limits::max(), Limits::lowest()};
+        if (random.below(2) == 0) { return specials[random.below(sizeof(specials) / sizeof(specials[0]))]; }
+        using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        T value;
+        do { value = std::bit_cast<T>(static_cast<Bits>(random())); } while (std::isnan(value));
+        return value;
+    }
+    else {
+        using Limits = std::numeric_limits<T>;
+        const T specials[] = {T(0), T(1), static_cast<T>(-1), Limits::min(), Limits::max()};
+        if (random.below(2) == 0) { return specials[random.below(sizeof(specials) / sizeof(specials[0]))]; }
+        return static_cast<T>(random());
+    }
+}
+
+template<class T>
+std::vector<T> random_values(bench::Random& random, const size_t size) {
+    std::vector<T> values(size);
+    for (T& value : values) { value = random_value<T>(random); }
+    return values;
+}
+
+// 大小跨过插入排序的阈值 radix_sort::SMALL_RADIX
+template<class T>
+void test_radix_keys(const size_t large) {
+    bench::Random random;
+    for (const size_t size : {size_t(0), size_t(1), size_t(2), size_t(63), size_t(64), size_t(65), size_t(1000), large}) {
+        std::vector<T> expected = random_values<T>(random, size);
+        MyVector<T> data(expected.begin(), expected.end());
+        MySort(SortType::radix)(data);
+        std::stable_sort(expected.begin(), expected.end(), TotalLess());
+        BENCH_CHECK(same_bits(data, expected));
+    }
+}
+
+// 高位字节全部相同的键会跳过对应的趟数，结果可能停在辅助缓冲区中再移回
+void test_radix_narrow_range(const size_t large) {
+    bench::Random random;
+    std::vector<int64_t> expected(large);
+    for (int64_t& value : expected) { value = static_cast<int64_t>(random.below(512)) - 256; }
+    MyVector<int64_t> data(expected.begin(), expected.end());
+    MySort(SortType::radix)(data);
+    std::sort(expected.begin(), expected.end());
+    BENCH_CHECK(same_bits(data, expected));
+}
+
+// 键相等的元素保持原来的顺序
+void test_radix_stable(const size_t large) {
+    struct Item {
+        double key;
+        size_t index;
+    };
+    bench::Random random;
+    std::vector<Item> items(large);
+    for (size_t i = 0; i < large; i++) { items[i] = {random.below(2) == 0 ? -0.0 : static_cast<double>(random.below(64)) - 32, i}; }
+    radix_sort::sort(items.data(), items.data() + items.size(), [](const Item& item) { return item.key; },
+                     std::allocator<Item>());
+    for (size_t i = 1; i < items.size(); i++) {
+        const Item& prev = items[i - 1];
+        const Item& item = items[i];
+        BENCH_CHECK(!TotalLess()(item.key, prev.key));
+        BENCH_CHECK(TotalLess()(prev.key, item.key) || prev.index < item.index);
+    }
+}
+
+// 网络把负浮点数变换为有序的整数再比较，-0.0 同样排在 +0.0 前面，结果与 TotalLess 逐位一致
+template<class T>
+void check_network(void (*sort)(T*, size_t), bench::Random& random) {
+    for (size_t size = 2; size <= sort_network::MAX_SIZE; size++) {
+        for (int round = 0; round < 50; round++) {
+            std::vector<T> expected = random_values<T>(random, size);
+            std::vector<T> data = expected;
+            sort(data.data(), size);
+            std::stable_sort(expected.begin(), expected.end(), TotalLess());
+            BENCH_CHECK(same_bits(data, expected));
+        }
+    }
+}
+
+template<class T>
+void test_network() {
+    bench::Random random;
+    check_network<T>(sort_network::sort<T>, random);
+#if defined(__GNUC__) && MY_SIMD_X86
+    const my_simd::Isa isa = my_simd::isa();
+    if (isa >= my_simd::Isa::SSE2) { check_network<T>(sort_network::sort_sse2<T>, random); }
+    if (isa >= my_simd::Isa::AVX2) { check_network<T>(sort_network::sort_avx2<T>, random); }
+    if (isa >= my_simd::Isa::AVX512) { check_network<T>(sort_network::sort_avx512<T>, random); }
+#endif
+}
+
+// 经过 MySort 的 quick 与 merge 时网络只是基础情形，按 < 比较 -0.0 与 +0.0 相等，只要求有序且是原数组的排列
+template<class T>
+void test_network_in_sorts() {
+    bench::Random random;
+    for (const SortType type : {SortType::quick, SortType::merge}) {
+        for (size_t size = 2; size <= 4 * sort_network::MAX_SIZE + 1; size++) {
+            std::vector<T> expected = random_values<T>(random, size);
+            MyVector<T> data(expected.begin(), expected.end());
+            const MySort sorter(type);
+            sorter(data);
+            BENCH_CHECK(std::is_sorted(data.data(), data.data() + data.size()));
+            std::vector<T> sorted(data.data(), data.data() + data.size());
+            std::stable_sort(sorted.begin(), sorted.end(), TotalLess());
+            std::stable_sort(expected.begin(), expected.end(), TotalLess());
+            BENCH_CHECK(same_bits(sorted, expected));
+        }
+    }
+}
+
+static constexpr SortType ALL_TYPES[] = {SortType::bubble, SortType::choose, SortType::insert,
+                                         SortType::shell,  SortType::quick,  SortType::heap,
+                                         SortType::merge,  SortType::radix,  SortType::parallel};
+static constexpr size_t QUADRATIC_LIMIT = 2000;  // bubble / choose / insert 只排这么多个元素
+
+bool is_stable(const SortType type) {
+    return type == SortType::bubble || type == SortType::insert || type == SortType::merge || type == SortType::radix;
+}
+
+// parallel 至少要有 2 * THREAD_GRAIN 个元素才真正分给多个线程
+std::vector<size_t> sizes_for(const SortType type, const size_t large) {
+    if (type == SortType::bubble || type == SortType::choose || type == SortType::insert) {
+        return {0, 1, 2, 33, QUADRATIC_LIMIT};
+    }
+    if (type == SortType::parallel) { return {0, 1, 2, 33, large, 4 * parallel_sort::THREAD_GRAIN + 3}; }
+    return {0, 1, 2, 33, large};
+}
+
+// 结果按 less 有序，且与 original 是同一组值（浮点数逐位比较）
+template<class T, class Less>
+void check_sorted(const MyVector<T>& data, std::vector<T> original, Less less) {
+    BENCH_CHECK(std::is_sorted(data.data(), data.data() + data.size(), less));
+    std::vector<T> sorted(data.data(), data.data() + data.size());
+    std::stable_sort(sorted.begin(), sorted.end(), TotalLess());
+    std::stable_sort(original.begin(), original.end(), TotalLess());
+    BENCH_CHECK(same_bits(sorted, original));
+}
+
+// 每种算法按默认的 < 以及 std::greater 排序
+template<class T>
+void test_all_types(const size_t large) {
+    bench::Random random;
+    for (const SortType type : ALL_TYPES) {
+        const MySort sorter(type, 4);
+        for (const size_t size : sizes_for(type, large)) {
+            const std::vector<T> original = random_values<T>(random, size);
+            MyVector<T> data(original.begin(), original.end());
+            sorter(data);
+            check_sorted(data, original, std::less<T>());
+            MyVector<T> reversed(original.begin(), original.end());
+            sorter(reversed, std::greater<>());
+            check_sorted(reversed, original, std::greater<T>());
+            MyVector<T> typed(original.begin(), original.end());
+            sorter(typed, std::greater<T>());
+            check_sorted(typed, original, std::greater<T>());
+        }
+    }
+}
+
+// 自定义比较按绝对值排序；radix 不支持，抛出 std::invalid_argument
+void test_custom_comparator(const size_t large) {
+    bench::Random random;
+    const auto by_magnitude = [](const int32_t lhs, const int32_t rhs) {
+        return std::abs(static_cast<int64_t>(lhs)) < std::abs(static_cast<int64_t>(rhs));
+    };
+    for (const SortType type : ALL_TYPES) {
+        const MySort sorter(type, 4);
+        for (const size_t size : sizes_for(type, large)) {
+            const std::vector<int32_t> original = random_values<int32_t>(random, size);
+            MyVector<int32_t> data(original.begin(), original.end());
+            if (type == SortType::radix) {
+                bool thrown = false;
+                try { sorter(data, by_magnitude); }
+                catch (const std::invalid_argument&) { thrown = true; }
+                BENCH_CHECK(thrown);
+                continue;
+            }
+            sorter(data, by_magnitude);
+            check_sorted(data, original, by_magnitude);
+        }
+    }
+}
+
+struct Record {
+    int64_t key;
+    double weight;
+    size_t index;  // 排序前的位置
+};
+
+std::vector<Record> random_records(bench::Random& random, const size_t size) {
+    std::vector<Record> records(size);
+    for (size_t i = 0; i < size; i++) {
+        // 键的取值很少，相等的键大量出现，稳定性才能被检验
+        const double weight = random.below(4) == 0 ? (random.below(2) == 0 ? -0.0 : 0.0)
+                                                   : static_cast<double>(random.below(16)) - 8;
+        records[i] = {static_cast<int64_t>(random.below(32)) - 16, weight, i};
+    }
+    return records;
+}
+
+// 结果是 original 的一个排列，按 less 比较 proj 有序；stable 时键相等的元素保持原来的顺序
+template<class Less, class Proj>
+void check_records(const MyVector<Record>& data, const std::vector<Record>& original, Less less, Proj proj,
+                   const bool stable) {
+    BENCH_CHECK(data.size() == original.size());
+    std::vector<bool> seen(original.size(), false);
+    for (size_t i = 0; i < data.size(); i++) {
+        const Record& record = data[i];
+        BENCH_CHECK(record.index < original.size() && !seen[record.index]);
+        seen[record.index] = true;
+        const Record& source = original[record.index];
+        BENCH_CHECK(record.key == source.key && std::bit_cast<uint64_t>(record.weight) == std::bit_cast<uint64_t>(source.weight));
+        if (i == 0) { continue; }
+        const Record& prev = data[i - 1];
+        BENCH_CHECK(!less(std::invoke(proj, record), std::invoke(proj, prev)));
+        if (stable && !less(std::invoke(proj, prev), std::invoke(proj, record))) { BENCH_CHECK(prev.index < record.index); }
+    }
+}
+
+// 成员指针与 lambda 投影，配合 std::less 与 std::greater；radix 对 double 键降序时 +0.0 排在 -0.0 前面
+void test_projection(const size_t large) {
+    bench::Random random;
+    const TotalLess total_less;
+    const auto total_greater = [total_less](const double lhs, const double rhs) { return total_less(rhs, lhs); };
+    for (const SortType type : ALL_TYPES) {
+        const MySort sorter(type, 4);
+        const bool stable = is_stable(type);
+        for (const size_t size : sizes_for(type, large)) {
+            const std::vector<Record> original = random_records(random, size);
+            MyVector<Record> data(original.begin(), original.end());
+            sorter(data, std::less<>(), &Record::key);
+            check_records(data, original, std::less<>(), &Record::key, stable);
+
+            data = MyVector<Record>(original.begin(), original.end());
+            sorter(data, std::greater<>(), &Record::key);
+            check_records(data, original, std::greater<>(), &Record::key, stable);
+
+            data = MyVector<Record>(original.begin(), original.end());
+            sorter(data, std::greater<double>(), [](const Record& record) { return record.weight; });
+            // radix 区分 -0.0 与 +0.0，按 std::greater 相等的键不一定保持原来的顺序
+            check_records(data, original, std::greater<>(), &Record::weight, stable && type != SortType::radix);
+            if (type == SortType::radix) { check_records(data, original, total_greater, &Record::weight, true); }
+        }
+    }
+}
+
+// 每个元素只计算一次键，所有算法下结果都是稳定的
+void test_cached_key(const size_t large) {
+    bench::Random random;
+    for (const SortType type : ALL_TYPES) {
+        const MySort sorter(type, 4);
+        for (const size_t size : sizes_for(type, large)) {
+            const std::vector<Record> original = random_records(random, size);
+            size_t calls = 0;
+            const auto key_of = [&calls](const Record& record) {
+                calls++;
+                return record.key;
+            };
+            MyVector<Record> data(original.begin(), original.end());
+            sorter.sort_by_cached_key(data, key_of);
+            BENCH_CHECK(calls == size);
+            check_records(data, original, std::less<>(), &Record::key, true);
+
+            calls = 0;
+            data = MyVector<Record>(original.begin(), original.end());
+            sorter.sort_by_cached_key(data, key_of, std::greater<>());
+            BENCH_CHECK(calls == size);
+            check_records(data, original, std::greater<>(), &Record::key, true);
+        }
+    }
+}
+
+int main(const int argc, char** argv) {
+    const size_t large = bench::arg(argc, argv, 1, 100000);
+    test_radix_keys<float>(large);
+    test_radix_keys<double>(large);
+    test_radix_keys<int64_t>(large);
+    test_radix_keys<int32_t>(large);
+    test_radix_keys<int16_t>(large);
+    test_radix_keys<int8_t>(large);
+    test_radix_keys<uint64_t>(large);
+    test_radix_narrow_range(large);
+    test_radix_stable(large);
+    test_network<float>();
+    test_network<double>();
+    test_network<int32_t>();
+    test_network<int64_t>();
+    test_network<uint32_t>();
+    test_network_in_sorts<float>();
+    test_network_in_sorts<double>();
+    test_all_types<int64_t>(large);
+    test_all_types<double>(large);
+    test_all_types<float>(large);
+    test_custom_comparator(large);
+    test_projection(large);
+    test_cached_key(large);
+    std::puts("ok");
+    return 0;
+}
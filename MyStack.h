@@ -2,13 +2,14 @@
 #include "MyDeque.h"
 #include <stdexcept>
 
-template<class T>
+template<class T, class Alloc = MyAllocator<T>>
 class MyStack {
 private:
-    MyDeque<T> container;  // 使用 MyDeque 作为底层容器
+    MyDeque<T, Alloc> container;  // 使用 MyDeque 作为底层容器
 
 public:
     MyStack() = default;
+    explicit MyStack(const Alloc& alloc) : container(alloc) {}
     MyStack(const MyStack& other) : container(other.container) {}
     ~MyStack()  = default;
     MyStack& operator=(const MyStack& other) {
@@ -34,4 +35,5 @@ public:
     bool empty() const { return container.empty(); }
     size_t size() const { return container.size(); }
     void clear() { container.clear(); }
+    Alloc get_allocator() const { return container.get_allocator(); }
 };
@@ -1,26 +1,167 @@
 #pragma once
+#include <bit>
+#include <charconv>
 #include <cstring>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include "MyAllocator.h"
+#include "MyStringView.h"
+#include "StringInput.h"
 
-class MyString {
+template<class Alloc = MyAllocator<char>>
+class MyBasicString {
 private:
-    static constexpr int START_SIZE = 16;
+    using Traits = std::allocator_traits<Alloc>;
     static constexpr int MULTIPLE = 2;
-    size_t length;
-    size_t capacity;
-    char* ptr;
 
-    // Helper function to allocate new memory and copy
-    void allocate_and_copy(const char* source, size_t new_length) {
-        capacity = START_SIZE;
-        while (capacity <= new_length) { capacity *= MULTIPLE; }
-        ptr = new char[capacity + 1];  // 多分配一个字节用于空字符
-        memcpy(ptr, source, new_length);
-        ptr[new_length] = '\0';  // 添加空字符结尾
-        length = new_length;
+    // 长字符串存放在堆上；短字符串直接存放在这 24 个字节（32 位平台为 12 个字节）中，不申请内存。
+    // 最后一个字节是标记：短字符串时为剩余容量 LOCAL_CAPACITY - length，长度取满时恰好是结尾的空字符；
+    // 长字符串时它是 capacity 的一部分，最高位置 1
+    struct Heap {
+        char* ptr;
+        size_t length;
+        size_t capacity;  // 经过 encode 的容量
+    };
+    static constexpr size_t LOCAL_CAPACITY = sizeof(Heap) - 1;
+    static constexpr unsigned char HEAP_FLAG = 0x80;
+
+    [[no_unique_address]] Alloc alloc;
+    union {
+        Heap heap{};  // 先整体清零，短字符串只写用到的字节
+        char local[sizeof(Heap)];
+    };
+
+    // 让 capacity 的最后一个字节带上 HEAP_FLAG
+    static size_t encode(const size_t buffer_capacity) {
+        if constexpr (std::endian::native == std::endian::little) {
+            return buffer_capacity | static_cast<size_t>(HEAP_FLAG) << (8 * (sizeof(size_t) - 1));
+        }
+        else { return buffer_capacity << 8 | HEAP_FLAG; }
+    }
+    static size_t decode(const size_t encoded) {
+        if constexpr (std::endian::native == std::endian::little) {
+            return encoded & ~(static_cast<size_t>(HEAP_FLAG) << (8 * (sizeof(size_t) - 1)));
+        }
+        else { return encoded >> 8; }
+    }
+
+    [[nodiscard]] bool is_small() const {
+        return (static_cast<unsigned char>(local[LOCAL_CAPACITY]) & HEAP_FLAG) == 0;
+    }
+    [[nodiscard]] char* buffer() const { return is_small() ? const_cast<char*>(local) : heap.ptr; }
+    [[nodiscard]] size_t capacity() const { return is_small() ? LOCAL_CAPACITY : decode(heap.capacity); }
+
+    // 设置长度并补上结尾的空字符
+    void set_length(const size_t new_length) {
+        if (is_small()) {
+            local[new_length] = '\0';
+            local[LOCAL_CAPACITY] = static_cast<char>(LOCAL_CAPACITY - new_length);
+        }
+        else {
+            heap.length = new_length;
+            heap.ptr[new_length] = '\0';
+        }
+    }
+    void init_small() {
+        local[0] = '\0';
+        local[LOCAL_CAPACITY] = static_cast<char>(LOCAL_CAPACITY);
+    }
+
+    // 缓冲区总是比 capacity 多一个字节用于空字符
+    char* new_buffer(const size_t buffer_capacity) { return Traits::allocate(alloc, buffer_capacity + 1); }
+    void delete_buffer(char* buffer, const size_t buffer_capacity) {
+        if (buffer != nullptr) { Traits::deallocate(alloc, buffer, buffer_capacity + 1); }
+    }
+    void release() {
+        if (!is_small()) { delete_buffer(heap.ptr, decode(heap.capacity)); }
+    }
+
+    // 构造时调用：放得下就存在对象内部，否则按实际长度申请
+    void init_copy(const char* source, const size_t new_length) {
+        if (new_length <= LOCAL_CAPACITY) {
+            memcpy(local, source, new_length);
+            local[new_length] = '\0';
+            local[LOCAL_CAPACITY] = static_cast<char>(LOCAL_CAPACITY - new_length);
+            return;
+        }
+        char* temp_ptr = new_buffer(new_length);
+        memcpy(temp_ptr, source, new_length);
+        temp_ptr[new_length] = '\0';
+        heap.ptr = temp_ptr;
+        heap.length = new_length;
+        heap.capacity = encode(new_length);
+    }
+
+    static constexpr char WHITESPACE[] = " \t\n\v\f\r";
+
+    static bool is_space(const char ch) { return ch == ' ' || (ch >= '\t' && ch <= '\r'); }
+
+    // 跳过空白，流在此之前结束时设置 eofbit 和 failbit 并返回 false
+    static bool skip_space(std::istream& in, string_input::StreamChunks& chunks) {
+        const char* data;
+        size_t count;
+        while (chunks.peek(data, count)) {
+            if (!is_space(data[0])) { return true; }  // 常见情况：没有前导空白
+            const size_t start = string_search::find_first_not_of(data, count, WHITESPACE, sizeof(WHITESPACE) - 1);
+            if (start != npos) {
+                chunks.consume(start);
+                return true;
+            }
+            chunks.consume(count);
+        }
+        in.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+        return false;
+    }
+
+    [[nodiscard]] MyStringView as_view() const { return MyStringView(buffer(), size()); }
+
+    // 把 [str, str + count) 接在末尾；str 可以指向本字符串，需要扩容时先复制完再释放旧缓冲区
+    void append_raw(const char* str, const size_t count) {
+        const size_t length = size();
+        if (length + count > capacity()) {
+            const size_t new_capacity = (length + count) * MULTIPLE;
+            char* temp_ptr = new_buffer(new_capacity);
+            memcpy(temp_ptr, buffer(), length);
+            memcpy(temp_ptr + length, str, count);
+            temp_ptr[length + count] = '\0';
+            release();
+            heap.ptr = temp_ptr;
+            heap.length = length + count;
+            heap.capacity = encode(new_capacity);
+            return;
+        }
+        memcpy(buffer() + length, str, count);
+        set_length(length + count);  // 确保字符串以空字符结尾
+    }
+
+    // 保证末尾还能直接写入 count 个字符（按倍数扩容），返回写入位置
+    char* prepare_append(const size_t count) {
+        const size_t length = size();
+        if (length + count > capacity()) {
+            const size_t doubled = capacity() * MULTIPLE;
+            reserve(length + count > doubled ? length + count : doubled);
+        }
+        return buffer() + length;
+    }
+
+    MyBasicString concat(const char* str, const size_t count) const {
+        const size_t length = size();
+        MyBasicString temp(alloc);
+        temp.reserve(length + count);
+        memcpy(temp.buffer(), buffer(), length);
+        memcpy(temp.buffer() + length, str, count);
+        temp.set_length(length + count);  // 添加空字符
+        return temp;
     }
 
 public:
+    static constexpr size_t npos = string_search::NOT_FOUND;
+    // 数字格式化后的最大长度
+    template<class T>
+    static constexpr size_t MAX_INT_CHARS = std::numeric_limits<T>::digits10 + 2;
+    static constexpr size_t MAX_DOUBLE_CHARS = 32;
+
     class StringIterator{
         private:
         char* ptr;
@@ -49,142 +190,198 @@ public:
         bool operator<=(const StringIterator& source) const { return ptr <= source.ptr; }
         bool operator>=(const StringIterator& source) const { return ptr >= source.ptr; }
     };
-    MyString() : length(0), capacity(START_SIZE), ptr(new char[START_SIZE + 1]) { ptr[0] = '\0'; }
-    MyString(const MyString& other) { allocate_and_copy(other.ptr, other.length); }
-    MyString(const char* other) {
-        if (other != nullptr) { allocate_and_copy(other, strlen(other)); }
-        else {
-            length = 0;
-            capacity = START_SIZE;
-            ptr = new char[capacity + 1];
-            ptr[0] = '\0';
-        }
+    MyBasicString() { init_small(); }
+    explicit MyBasicString(const Alloc& alloc_) : alloc(alloc_) { init_small(); }
+    MyBasicString(const MyBasicString& other) : alloc(Traits::select_on_container_copy_construction(other.alloc)) {
+        if (other.is_small()) { memcpy(local, other.local, sizeof(local)); }
+        else { init_copy(other.heap.ptr, other.heap.length); }
+    }
+    // 移动只复制对象本身的字节，长短字符串走同一条路径
+    MyBasicString(MyBasicString&& other) noexcept : alloc(std::move(other.alloc)) {
+        memcpy(local, other.local, sizeof(local));
+        other.init_small();
+    }
+    MyBasicString(const char* other, const Alloc& alloc_ = Alloc()) : alloc(alloc_) {
+        if (other != nullptr) { init_copy(other, strlen(other)); }
+        else { init_small(); }
     }
-    MyString(const char other) {
-        length = 1;
-        capacity = START_SIZE;
-        ptr = new char[capacity + 1];
-        *ptr = other;
-        ptr[1] = '\0';  // 添加空字符
+    MyBasicString(const char other, const Alloc& alloc_ = Alloc()) : alloc(alloc_) { init_copy(&other, 1); }
+    explicit MyBasicString(const MyStringView other, const Alloc& alloc_ = Alloc()) : alloc(alloc_) {
+        init_copy(other.data(), other.size());
     }
-    ~MyString() { delete[] ptr; }
+    ~MyBasicString() { release(); }
 
-    size_t size() const { return length; }
-    size_t str_capacity() const { return capacity; }
-    bool is_empty() const { return length == 0; }
+    size_t size() const {
+        return is_small() ? LOCAL_CAPACITY - static_cast<unsigned char>(local[LOCAL_CAPACITY]) : heap.length;
+    }
+    size_t str_capacity() const { return capacity(); }
+    bool is_empty() const { return size() == 0; }
 
-    MyString& append(const char ch) {
-        if (length >= capacity) { reserve(capacity * MULTIPLE); }
-        ptr[length] = ch;
-        length++;
-        ptr[length] = '\0';
+    MyBasicString& append(const char ch) {
+        const size_t length = size();
+        if (length >= capacity()) { reserve(capacity() * MULTIPLE); }
+        buffer()[length] = ch;
+        set_length(length + 1);
         return *this;
     }
-    void clear() {
-        length = 0;
-        ptr[0] = '\0';
-    }
+    void clear() { set_length(0); }
     void reserve(const size_t new_capacity) {
-        if (new_capacity > capacity) {
-            char* temp_ptr = new char[new_capacity + 1];
-            memcpy(temp_ptr, ptr, length);
-            temp_ptr[length] = '\0';
-            delete[] ptr;
-            ptr = temp_ptr;
-            capacity = new_capacity;
+        if (new_capacity > capacity()) {
+            const size_t length = size();
+            char* temp_ptr = new_buffer(new_capacity);
+            memcpy(temp_ptr, buffer(), length + 1);
+            release();
+            heap.ptr = temp_ptr;
+            heap.length = length;
+            heap.capacity = encode(new_capacity);
         }
     }
 
-    MyString& operator=(MyString other) {
-        std::swap(ptr, other.ptr);  // 使用 swap 技术避免重复内存分配
-        std::swap(length, other.length);
-        std::swap(capacity, other.capacity);
+    MyBasicString& operator=(MyBasicString other) {
+        std::swap(alloc, other.alloc);
+        char temp[sizeof(local)];  // 交换对象本身的字节，避免重复内存分配
+        memcpy(temp, local, sizeof(local));
+        memcpy(local, other.local, sizeof(local));
+        memcpy(other.local, temp, sizeof(local));
         return *this;
     }
-    MyString& operator=(const char* other) { return *this = MyString(other); }
-    MyString& operator=(const char other) { return *this = MyString(other); }
+    MyBasicString& operator=(const char* other) { return *this = MyBasicString(other, alloc); }
+    MyBasicString& operator=(const char other) { return *this = MyBasicString(other, alloc); }
+    MyBasicString& operator=(const MyStringView other) { return *this = MyBasicString(other, alloc); }
+
+    operator MyStringView() const { return as_view(); }
 
     // Concatenation operators
-    MyString operator+(const MyString& other) const {
-        MyString temp;
-        temp.length = length + other.length;
-        temp.capacity = START_SIZE;
-        while (temp.capacity <= temp.length) { temp.capacity *= MULTIPLE; }
-        temp.ptr = new char[temp.capacity + 1];
-        memcpy(temp.ptr, ptr, length);
-        memcpy(temp.ptr + length, other.ptr, other.length);
-        temp.ptr[temp.length] = '\0';  // 添加空字符
-        return temp;
-    }
-    MyString operator+(const char* other) const { return *this + MyString(other); }
-    MyString operator+(const char other) const { return *this + MyString(other); }
+    MyBasicString operator+(const MyBasicString& other) const { return concat(other.buffer(), other.size()); }
+    MyBasicString operator+(const MyStringView other) const { return concat(other.data(), other.size()); }
+    MyBasicString operator+(const char* other) const { return *this + MyStringView(other); }
+    MyBasicString operator+(const char other) const { return concat(&other, 1); }
 
-    MyString& operator+=(const MyString& other) {
-        if (length + other.length > capacity) {
-            reserve((length + other.length) * MULTIPLE);
-        }
-        memcpy(ptr + length, other.ptr, other.length);
-        length += other.length;
-        ptr[length] = '\0';  // 确保字符串以空字符结尾
+    MyBasicString& append(const MyStringView str) {
+        append_raw(str.data(), str.size());
         return *this;
     }
-    MyString& operator+=(const char* other) { return *this += MyString(other); }
-    MyString& operator+=(const char other) { append(other); return *this; }
+    MyBasicString& operator+=(const MyStringView other) { return append(other); }
+    MyBasicString& operator+=(const char other) { append(other); return *this; }
 
-    bool operator==(const MyString& other) const {
-        return length == other.length && memcmp(ptr, other.ptr, length) == 0;
+    // 数字直接格式化到缓冲区末尾，不经过 iostream 和 locale。浮点数输出能精确读回原值的最短形式
+    template<class T> requires std::is_integral_v<T> && (!std::is_same_v<T, bool>)
+    MyBasicString& append_int(const T value) {
+        char* first = prepare_append(MAX_INT_CHARS<T>);
+        const std::to_chars_result result = std::to_chars(first, first + MAX_INT_CHARS<T>, value);
+        set_length(static_cast<size_t>(result.ptr - buffer()));
+        return *this;
     }
-    bool operator!=(const MyString& other) const { return !(*this == other); }
-    bool operator<(const MyString& other) const {
-        const size_t min_len = length < other.length ? length : other.length;
-        for (size_t i = 0; i < min_len; i++) {
-            if (ptr[i] != other.ptr[i]) { return ptr[i] < other.ptr[i]; }
-        }
-        return length < other.length;
+    template<class T> requires std::is_floating_point_v<T>
+    MyBasicString& append_double(const T value) {
+        char* first = prepare_append(MAX_DOUBLE_CHARS);
+        const std::to_chars_result result = std::to_chars(first, first + MAX_DOUBLE_CHARS, value);
+        set_length(static_cast<size_t>(result.ptr - buffer()));
+        return *this;
     }
-    bool operator>(const MyString& other) const {
-        const size_t min_len = length < other.length ? length : other.length;
-        for (size_t i = 0; i < min_len; i++) {
-            if (ptr[i] != other.ptr[i]) { return ptr[i] > other.ptr[i]; }
-        }
-        return length > other.length;
+    // 整个字符串是合法数字时返回 true，见 MyStringView::to_int / to_double
+    template<class T> requires std::is_integral_v<T> && (!std::is_same_v<T, bool>)
+    bool to_int(T& value, const int base = 10) const { return as_view().to_int(value, base); }
+    template<class T> requires std::is_floating_point_v<T>
+    bool to_double(T& value) const { return as_view().to_double(value); }
+
+    // 查找操作，未找到时返回 npos，语义同 MyStringView
+    size_t find(const char ch, const size_t pos = 0) const { return as_view().find(ch, pos); }
+    size_t find(const MyStringView str, const size_t pos = 0) const { return as_view().find(str, pos); }
+    size_t rfind(const char ch, const size_t pos = npos) const { return as_view().rfind(ch, pos); }
+    size_t rfind(const MyStringView str, const size_t pos = npos) const { return as_view().rfind(str, pos); }
+    size_t find_first_of(const MyStringView chars, const size_t pos = 0) const {
+        return as_view().find_first_of(chars, pos);
+    }
+    size_t find_first_not_of(const MyStringView chars, const size_t pos = 0) const {
+        return as_view().find_first_not_of(chars, pos);
     }
-    bool operator<=(const MyString& other) const { return !(*this > other); }
-    bool operator>=(const MyString& other) const { return !(*this < other); }
+    bool contains(const char ch) const { return find(ch) != npos; }
+    bool contains(const MyStringView str) const { return find(str) != npos; }
+
+    // 切分出的字段是本字符串上的视图，字符串修改后失效
+    MyStringSplit split(const char delim) const { return as_view().split(delim); }
+    MyStringSplit split(const MyStringView delim) const { return as_view().split(delim); }
+    MyStringSplit tokenize(const MyStringView delims) const { return as_view().tokenize(delims); }
+
+    // 比较运算符（==、<=>）定义在 MyStringView.h 中，MyString 隐式转换为视图后比较
+    int compare(const MyStringView other) const { return as_view().compare(other); }
 
-    StringIterator begin() const { return ptr; }
-    StringIterator end() const { return ptr + length; }
+    Alloc get_allocator() const { return alloc; }
+
+    StringIterator begin() const { return buffer(); }
+    StringIterator end() const { return buffer() + size(); }
 
     // Subscript operator
-    char& operator[](const size_t index) const { return ptr[index]; }
+    char& operator[](const size_t index) const { return buffer()[index]; }
 
     // Friend functions for I/O
-    friend std::ostream& operator<<(std::ostream& out, const MyString& str) {
-        out << str.ptr;  // 输出时使用 C 风格字符串
+    friend std::ostream& operator<<(std::ostream& out, const MyBasicString& str) {
+        out << str.buffer();  // 输出时使用 C 风格字符串
         return out;
     }
-    friend std::istream& operator>>(std::istream& in, MyString& str) {
+    // 输入直接扫描流的读缓冲区，找到边界后整段追加，而不是逐个字符 get / append
+    friend std::istream& operator>>(std::istream& in, MyBasicString& str) {
         str.clear();
-        char ch;
-        while (in.get(ch) && std::isspace(ch)) {}  // 跳过前导空白
-        if (!in) return in;
-        str.append(ch);
-        while (in.get(ch) && !std::isspace(ch)) {
-            str.append(ch);
+        const std::istream::sentry guard(in, true);  // 前导空白由 skip_space 跳过
+        if (!guard) { return in; }
+        string_input::StreamChunks chunks(in.rdbuf());
+        if (!skip_space(in, chunks)) { return in; }
+        const char* data;
+        size_t count;
+        while (chunks.peek(data, count)) {
+            const size_t stop = string_search::find_first_of(data, count, WHITESPACE, sizeof(WHITESPACE) - 1);
+            if (stop != npos) {
+                str.append_raw(data, stop);
+                chunks.consume(stop);
+                return in;
+            }
+            str.append_raw(data, count);
+            chunks.consume(count);
         }
+        in.setstate(std::ios_base::eofbit);
         return in;
     }
-    friend std::istream& getline(std::istream& in, MyString& str, char delim = '\n') {
+    // 跳过前导空白后读到 delim 为止，delim 被丢弃
+    friend std::istream& getline(std::istream& in, MyBasicString& str, char delim = '\n') {
         str.clear();
-        char ch;
-        while (in.get(ch) && std::isspace(ch)) {}  // 跳过前导空白
-        if (!in) return in;
-        str.append(ch);
-        while (in.get(ch) && ch != delim) { str.append(ch); }
+        const std::istream::sentry guard(in, true);
+        if (!guard) { return in; }
+        string_input::StreamChunks chunks(in.rdbuf());
+        if (!skip_space(in, chunks)) { return in; }
+        const char* data;
+        size_t count;
+        while (chunks.peek(data, count)) {
+            const size_t stop = string_search::find_byte(data, count, delim);
+            if (stop != npos) {
+                str.append_raw(data, stop);
+                chunks.consume(stop + 1);
+                return in;
+            }
+            str.append_raw(data, count);
+            chunks.consume(count);
+        }
+        in.setstate(std::ios_base::eofbit);
         return in;
     }
 
 };
 
-inline MyString operator+(const char* other, const MyString& str) { return MyString(other) + str; }
-inline MyString operator+(const char other, const MyString& str) { return MyString(other) + str; }
+template<class Alloc>
+MyBasicString<Alloc> operator+(const MyStringView other, const MyBasicString<Alloc>& str) {
+    MyBasicString<Alloc> result(str.get_allocator());
+    result.reserve(other.size() + str.size());
+    result += other;
+    result += str;
+    return result;
+}
+template<class Alloc>
+MyBasicString<Alloc> operator+(const char* other, const MyBasicString<Alloc>& str) {
+    return MyStringView(other) + str;
+}
+template<class Alloc>
+MyBasicString<Alloc> operator+(const char other, const MyBasicString<Alloc>& str) {
+    return MyStringView(&other, 1) + str;
+}
+
+using MyString = MyBasicString<>;
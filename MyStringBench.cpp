@@ -0,0 +1,112 @@
+// MyString 的堆分配次数与耗时：短字符串存放在对象内部，不应向分配器申请内存。
+// 对照组是总在堆上分配的字符串，与引入内联存储之前的 MyString 相同。
+// 用法：MyStringBench [迭代次数]，默认 1000000
+#include <cstdio>
+#include <cstring>
+#include "Bench.h"
+#include "MyAllocator.h"
+#include "MyString.h"
+#include "MyVector.h"
+
+// 统计分配次数后转交给默认资源
+class CountingResource : public MemoryResource {
+public:
+    size_t allocations = 0;
+
+protected:
+    void* do_allocate(const size_t bytes, const size_t alignment) override {
+        allocations++;
+        return default_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* ptr, const size_t bytes, const size_t alignment) override {
+        default_resource()->deallocate(ptr, bytes, alignment);
+    }
+};
+
+using CountedString = MyBasicString<PolyAllocator<char>>;
+
+// 没有内联存储的字符串：即使是空串也持有一块堆内存，容量从 START_SIZE 开始倍增
+class HeapString {
+private:
+    static constexpr size_t START_SIZE = 16;
+    PolyAllocator<char> alloc;
+    size_t length = 0;
+    size_t capacity = START_SIZE;
+    char* ptr;
+
+    void init_copy(const char* source, const size_t num) {
+        while (capacity <= num) { capacity *= 2; }
+        ptr = alloc.allocate(capacity + 1);
+        memcpy(ptr, source, num);
+        ptr[num] = '\0';
+        length = num;
+    }
+
+public:
+    explicit HeapString(const PolyAllocator<char>& alloc_) : alloc(alloc_), ptr(alloc.allocate(START_SIZE + 1)) {
+        ptr[0] = '\0';
+    }
+    HeapString(const char* source, const PolyAllocator<char>& alloc_) : alloc(alloc_) {
+        init_copy(source, strlen(source));
+    }
+    HeapString(const HeapString& other) : alloc(other.alloc) { init_copy(other.ptr, other.length); }
+    HeapString& operator=(const HeapString&) = delete;
+    ~HeapString() { alloc.deallocate(ptr, capacity + 1); }
+
+    HeapString& operator+=(const char ch) {
+        if (length >= capacity) {
+            char* grown = alloc.allocate(capacity * 2 + 1);
+            memcpy(grown, ptr, length);
+            alloc.deallocate(ptr, capacity + 1);
+            ptr = grown;
+            capacity *= 2;
+        }
+        ptr[length++] = ch;
+        ptr[length] = '\0';
+        return *this;
+    }
+    char& operator[](const size_t index) const { return ptr[index]; }
+};
+
+// 每次迭代：构造、复制、默认构造后追加一个字符、把副本存入容器；返回分配次数，耗时写入 ms
+template<class String>
+size_t run(const char* const* words, const size_t word_num, const size_t num, double& ms) {
+    CountingResource resource;
+    MyVector<String> kept;
+    kept.reserve(num);  // 容器自身的缓冲区不经过 resource
+    const bench::Timer timer;
+    for (size_t i = 0; i < num; i++) {
+        const String word(words[i % word_num], &resource);
+        const String copy = word;
+        String built(&resource);
+        built += 'k';
+        kept.push_back(copy);
+    }
+    ms = timer.ms();
+    for (size_t i = 0; i < num; i++) { BENCH_CHECK(strcmp(&kept[i][0], words[i % word_num]) == 0); }
+    return resource.allocations;
+}
+
+int main(const int argc, char** argv) {
+    const size_t num = bench::arg(argc, argv, 1, 1000000);
+    // 只有最后一个超过内联容量
+    const char* words[] = {"id", "user_name", "timestamp", "GET", "/api/v1/items", "status=200", "x",
+                           "a-much-longer-token-past-the-inline-limit"};
+    constexpr size_t WORDS = sizeof(words) / sizeof(words[0]);
+
+    double inline_ms = 0;
+    double heap_ms = 0;
+    const size_t inline_count = run<CountedString>(words, WORDS, num, inline_ms);
+    const size_t heap_count = run<HeapString>(words, WORDS, num, heap_ms);
+    std::printf("sizeof(MyString)=%zu, %zu iterations\n", sizeof(MyString), num);
+    std::printf("%-12s %12s %10s\n", "", "allocations", "ms");
+    std::printf("%-12s %12zu %10.1f\n", "MyString", inline_count, inline_ms);
+    std::printf("%-12s %12zu %10.1f\n", "heap-only", heap_count, heap_ms);
+
+    // 每个长字符串构造、复制、存入容器各分配一次，短字符串不分配；对照组每次迭代分配四次
+    size_t long_words = 0;
+    for (size_t i = 0; i < num; i++) { long_words += i % WORDS == WORDS - 1; }
+    BENCH_CHECK(inline_count == 3 * long_words);
+    BENCH_CHECK(heap_count == 4 * num);
+    return 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <type_traits>
+#include <utility>
+#include "MyString.h"
+
+// 连续拼接字符串和数字：构造时预留一次空间，append(args...) 先按每个片段的最大长度估算总长，
+// 整批只检查一次容量，之后逐个直接写入缓冲区。最后用 release() 取走结果
+template<class Alloc = MyAllocator<char>>
+class MyBasicStringBuilder {
+private:
+    using String = MyBasicString<Alloc>;
+
+    String str;
+
+    static size_t max_length(const MyStringView piece) { return piece.size(); }
+    static size_t max_length(const char) { return 1; }
+    template<class T> requires std::is_integral_v<T> && (!std::is_same_v<T, bool>) && (!std::is_same_v<T, char>)
+    static size_t max_length(const T) { return String::template MAX_INT_CHARS<T>; }
+    template<class T> requires std::is_floating_point_v<T>
+    static size_t max_length(const T) { return String::MAX_DOUBLE_CHARS; }
+
+    void put(const MyStringView piece) { str.append(piece); }
+    void put(const char ch) { str.append(ch); }
+    template<class T> requires std::is_integral_v<T> && (!std::is_same_v<T, bool>) && (!std::is_same_v<T, char>)
+    void put(const T value) { str.append_int(value); }
+    template<class T> requires std::is_floating_point_v<T>
+    void put(const T value) { str.append_double(value); }
+
+    void ensure(const size_t count) {
+        const size_t needed = str.size() + count;
+        if (needed > str.str_capacity()) {
+            const size_t doubled = str.str_capacity() * 2;
+            str.reserve(needed > doubled ? needed : doubled);
+        }
+    }
+
+public:
+    explicit MyBasicStringBuilder(const size_t capacity = 0, const Alloc& alloc = Alloc()) : str(alloc) {
+        str.reserve(capacity);
+    }
+
+    // 片段可以是 MyString、MyStringView、C 字符串、char、整数或浮点数
+    template<class... Args>
+    MyBasicStringBuilder& append(const Args&... pieces) {
+        ensure((max_length(pieces) + ... + 0));
+        (put(pieces), ...);
+        return *this;
+    }
+    template<class T>
+    MyBasicStringBuilder& operator<<(const T& piece) { return append(piece); }
+
+    [[nodiscard]] size_t size() const { return str.size(); }
+    [[nodiscard]] MyStringView view() const { return str; }
+    void clear() { str.clear(); }
+
+    // 取走结果，builder 变为空
+    String release() { return std::move(str); }
+};
+
+using MyStringBuilder = MyBasicStringBuilder<>;
@@ -0,0 +1,263 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include "MyAllocator.h"
+#include "MyHash.h"
+#include "MyStringView.h"
+#include "MyVector.h"
+
+// 字符串驻留池：每个不同的字符串只在 arena 中存一份（带结尾空字符），返回从 0 开始连续编号的 Id。
+// 驻留过的字符串比较相等只需比较 Id，view(id) 直接返回 arena 中的视图，不申请内存。
+// 查找使用开放寻址（线性探测）哈希表，槽位里带有哈希值的高 32 位，多数不相等的候选不用比较字符。
+// 并发：查找持共享锁，插入持独占锁，适合读多写少；arena 和条目写入后不再移动，view 不加锁
+template<class Alloc = MyAllocator<char>>
+class MyBasicStringPool {
+public:
+    using Id = uint32_t;
+    static constexpr Id INVALID = UINT32_MAX;
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;  // arena 块大小，更长的字符串单独占一块
+    static constexpr size_t FIRST_SEGMENT = 1024;    // 条目分段存放，第 k 段有 FIRST_SEGMENT << k 个
+    static constexpr size_t SEGMENT_COUNT = 23;      // 总条目数超过 2^32
+    static constexpr size_t MIN_SLOTS = 64;
+    static constexpr size_t BATCH = 256;             // intern_all 每次加锁处理的字符串个数
+
+    struct Entry {
+        const char* ptr;
+        size_t length;
+        uint64_t hash;
+    };
+    struct Slot {
+        uint32_t tag;  // 哈希值高 32 位
+        Id id;         // INVALID 表示空槽
+    };
+    struct Block {
+        char* ptr;
+        size_t size;
+    };
+    using EntryAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Entry>;
+    using SlotAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Slot>;
+    using BlockAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Block>;
+    using Traits = std::allocator_traits<Alloc>;
+    using EntryTraits = std::allocator_traits<EntryAlloc>;
+    using SlotTraits = std::allocator_traits<SlotAlloc>;
+
+    [[no_unique_address]] Alloc alloc;
+    [[no_unique_address]] EntryAlloc entry_alloc;
+    [[no_unique_address]] SlotAlloc slot_alloc;
+    mutable std::shared_mutex lock;
+    MyVector<Block, BlockAlloc> blocks;
+    char* cursor = nullptr;
+    size_t remaining = 0;
+    std::atomic<Entry*> segments[SEGMENT_COUNT] = {};
+    std::atomic<size_t> count{0};
+    Slot* slots = nullptr;
+    size_t slot_count = 0;  // 2 的幂
+
+    static uint64_t hash_of(const MyStringView str) { return my_hash::hash_bytes(str.data(), str.size()); }
+    static uint32_t tag_of(const uint64_t hash) { return static_cast<uint32_t>(hash >> 32); }
+
+    // id 所在的段和段内下标：第 k 段覆盖 [FIRST_SEGMENT * (2^k - 1), FIRST_SEGMENT * (2^(k+1) - 1))
+    static size_t segment_of(const size_t id) { return std::bit_width(id / FIRST_SEGMENT + 1) - 1; }
+    static size_t segment_start(const size_t segment) { return FIRST_SEGMENT * ((size_t(1) << segment) - 1); }
+
+    const Entry& entry(const Id id) const {
+        const size_t segment = segment_of(id);
+        return segments[segment].load(std::memory_order_acquire)[id - segment_start(segment)];
+    }
+
+    // 以下 *_locked 函数要求调用者持有锁
+    [[nodiscard]] Id find_locked(const MyStringView str, const uint64_t hash) const {
+        if (slots == nullptr) { return INVALID; }
+        const size_t mask = slot_count - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const Slot& slot = slots[i];
+            if (slot.id == INVALID) { return INVALID; }
+            if (slot.tag == tag_of(hash)) {
+                const Entry& candidate = entry(slot.id);
+                if (candidate.length == str.size() && memcmp(candidate.ptr, str.data(), str.size()) == 0) {
+                    return slot.id;
+                }
+            }
+        }
+    }
+
+    void place(const uint64_t hash, const Id id) {
+        const size_t mask = slot_count - 1;
+        size_t i = hash & mask;
+        while (slots[i].id != INVALID) { i = (i + 1) & mask; }
+        slots[i] = Slot{tag_of(hash), id};
+    }
+
+    // 保证 total 个字符串装入后负载不超过 3/4
+    void reserve_locked(const size_t total) {
+        if (total * 4 <= slot_count * 3) { return; }
+        size_t new_count = slot_count == 0 ? MIN_SLOTS : slot_count;
+        while (total * 4 > new_count * 3) { new_count *= 2; }
+        Slot* new_slots = SlotTraits::allocate(slot_alloc, new_count);
+        for (size_t i = 0; i < new_count; i++) { new_slots[i] = Slot{0, INVALID}; }
+        Slot* old_slots = slots;
+        const size_t old_count = slot_count;
+        slots = new_slots;
+        slot_count = new_count;
+        const size_t size_ = count.load(std::memory_order_relaxed);
+        for (size_t id = 0; id < size_; id++) { place(entry(static_cast<Id>(id)).hash, static_cast<Id>(id)); }
+        if (old_slots != nullptr) { SlotTraits::deallocate(slot_alloc, old_slots, old_count); }
+    }
+
+    // 把字符复制进 arena，末尾补空字符
+    const char* store(const MyStringView str) {
+        const size_t need = str.size() + 1;
+        char* result;
+        if (need > BLOCK_SIZE) {  // 超长字符串独占一块，当前块剩余空间继续使用
+            result = Traits::allocate(alloc, need);
+            blocks.push_back(Block{result, need});
+        }
+        else {
+            if (need > remaining) {
+                cursor = Traits::allocate(alloc, BLOCK_SIZE);
+                remaining = BLOCK_SIZE;
+                blocks.push_back(Block{cursor, BLOCK_SIZE});
+            }
+            result = cursor;
+            cursor += need;
+            remaining -= need;
+        }
+        memcpy(result, str.data(), str.size());
+        result[str.size()] = '\0';
+        return result;
+    }
+
+    Id intern_locked(const MyStringView str, const uint64_t hash) {
+        const Id found = find_locked(str, hash);
+        if (found != INVALID) { return found; }
+        const size_t id = count.load(std::memory_order_relaxed);
+        if (id == INVALID) { throw std::length_error("string pool is full"); }
+        reserve_locked(id + 1);
+        const size_t segment = segment_of(id);
+        Entry* entries = segments[segment].load(std::memory_order_relaxed);
+        if (entries == nullptr) {
+            entries = EntryTraits::allocate(entry_alloc, FIRST_SEGMENT << segment);
+            segments[segment].store(entries, std::memory_order_release);
+        }
+        entries[id - segment_start(segment)] = Entry{store(str), str.size(), hash};
+        place(hash, static_cast<Id>(id));
+        count.store(id + 1, std::memory_order_release);
+        return static_cast<Id>(id);
+    }
+
+    void release() {
+        for (const Block& block : blocks) { Traits::deallocate(alloc, block.ptr, block.size); }
+        blocks.clear();
+        cursor = nullptr;
+        remaining = 0;
+        for (size_t segment = 0; segment < SEGMENT_COUNT; segment++) {
+            Entry* entries = segments[segment].exchange(nullptr, std::memory_order_relaxed);
+            if (entries != nullptr) { EntryTraits::deallocate(entry_alloc, entries, FIRST_SEGMENT << segment); }
+        }
+        count.store(0, std::memory_order_relaxed);
+        if (slots != nullptr) { SlotTraits::deallocate(slot_alloc, slots, slot_count); }
+        slots = nullptr;
+        slot_count = 0;
+    }
+
+    // 接管 other 的全部内存，other 变为空池
+    void take(MyBasicStringPool& other) {
+        blocks.move(other.blocks);
+        cursor = other.cursor;
+        remaining = other.remaining;
+        for (size_t segment = 0; segment < SEGMENT_COUNT; segment++) {
+            segments[segment].store(other.segments[segment].exchange(nullptr, std::memory_order_relaxed),
+                                    std::memory_order_relaxed);
+        }
+        count.store(other.count.exchange(0, std::memory_order_relaxed), std::memory_order_release);
+        slots = other.slots;
+        slot_count = other.slot_count;
+        other.cursor = nullptr;
+        other.remaining = 0;
+        other.slots = nullptr;
+        other.slot_count = 0;
+    }
+
+public:
+    explicit MyBasicStringPool(const Alloc& alloc_ = Alloc())
+        : alloc(alloc_), entry_alloc(alloc_), slot_alloc(alloc_), blocks(BlockAlloc(alloc_)) {}
+    // 复制时按 Id 顺序重新驻留，Id 保持不变
+    MyBasicStringPool(const MyBasicStringPool& other)
+        : alloc(Traits::select_on_container_copy_construction(other.alloc)), entry_alloc(alloc), slot_alloc(alloc),
+          blocks(BlockAlloc(alloc)) {
+        const std::shared_lock<std::shared_mutex> guard(other.lock);
+        const size_t size_ = other.count.load(std::memory_order_relaxed);
+        reserve_locked(size_);
+        for (size_t id = 0; id < size_; id++) {
+            const Entry& source = other.entry(static_cast<Id>(id));
+            intern_locked(MyStringView(source.ptr, source.length), source.hash);
+        }
+    }
+    MyBasicStringPool(MyBasicStringPool&& other) noexcept
+        : alloc(std::move(other.alloc)), entry_alloc(alloc), slot_alloc(alloc), blocks(BlockAlloc(alloc)) {
+        take(other);
+    }
+    MyBasicStringPool& operator=(MyBasicStringPool other) {
+        const std::unique_lock<std::shared_mutex> guard(lock);
+        release();
+        alloc = other.alloc;
+        entry_alloc = EntryAlloc(alloc);
+        slot_alloc = SlotAlloc(alloc);
+        take(other);
+        return *this;
+    }
+    ~MyBasicStringPool() { release(); }
+
+    // 返回 str 的 Id，第一次出现时复制进池中
+    Id intern(const MyStringView str) {
+        const uint64_t hash = hash_of(str);
+        {
+            const std::shared_lock<std::shared_mutex> guard(lock);
+            const Id found = find_locked(str, hash);
+            if (found != INVALID) { return found; }
+        }
+        const std::unique_lock<std::shared_mutex> guard(lock);
+        return intern_locked(str, hash);  // 加锁期间可能已被其他线程插入，intern_locked 会重新查找
+    }
+
+    // 批量驻留 strings[0, num)，Id 写入 out。哈希在锁外计算，每 BATCH 个字符串加一次锁，表只扩容一次
+    void intern_all(const MyStringView* strings, const size_t num, Id* out) {
+        uint64_t hashes[BATCH];
+        for (size_t base = 0; base < num; base += BATCH) {
+            const size_t batch = num - base < BATCH ? num - base : BATCH;
+            for (size_t i = 0; i < batch; i++) { hashes[i] = hash_of(strings[base + i]); }
+            const std::unique_lock<std::shared_mutex> guard(lock);
+            if (base == 0) { reserve_locked(count.load(std::memory_order_relaxed) + num); }
+            for (size_t i = 0; i < batch; i++) { out[base + i] = intern_locked(strings[base + i], hashes[i]); }
+        }
+    }
+
+    // 不插入，未驻留时返回 INVALID
+    [[nodiscard]] Id find(const MyStringView str) const {
+        const uint64_t hash = hash_of(str);
+        const std::shared_lock<std::shared_mutex> guard(lock);
+        return find_locked(str, hash);
+    }
+    [[nodiscard]] bool contains(const MyStringView str) const { return find(str) != INVALID; }
+
+    // id 必须是本池返回过的值
+    [[nodiscard]] MyStringView view(const Id id) const {
+        const Entry& found = entry(id);
+        return MyStringView(found.ptr, found.length);
+    }
+    [[nodiscard]] const char* c_str(const Id id) const { return entry(id).ptr; }
+
+    [[nodiscard]] size_t size() const { return count.load(std::memory_order_acquire); }
+    [[nodiscard]] bool is_empty() const { return size() == 0; }
+    Alloc get_allocator() const { return alloc; }
+};
+
+using MyStringPool = MyBasicStringPool<>;
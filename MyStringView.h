@@ -0,0 +1,237 @@
+#pragma once
+#include <charconv>
+#include <compare>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include "StringSearch.h"
+
+class MyStringSplit;
+
+// 不持有内存的字符串视图（指针 + 长度），不保证以空字符结尾。
+// MyString 可以隐式转换为视图，比较、查找和拼接都以视图为参数，避免构造临时字符串
+class MyStringView {
+private:
+    const char* ptr;
+    size_t length;
+
+public:
+    static constexpr size_t npos = string_search::NOT_FOUND;
+
+    constexpr MyStringView() : ptr(""), length(0) {}
+    MyStringView(const char* str) : ptr(str != nullptr ? str : ""), length(str != nullptr ? strlen(str) : 0) {}
+    constexpr MyStringView(const char* str, const size_t count) : ptr(count > 0 ? str : ""), length(count) {}
+
+    [[nodiscard]] constexpr const char* data() const { return ptr; }
+    [[nodiscard]] constexpr size_t size() const { return length; }
+    [[nodiscard]] constexpr bool is_empty() const { return length == 0; }
+    [[nodiscard]] constexpr bool empty() const { return length == 0; }
+
+    constexpr const char* begin() const { return ptr; }
+    constexpr const char* end() const { return ptr + length; }
+    constexpr char operator[](const size_t index) const { return ptr[index]; }
+    constexpr char front() const { return ptr[0]; }
+    constexpr char back() const { return ptr[length - 1]; }
+
+    // [pos, pos + count) 与末尾取较小者
+    [[nodiscard]] MyStringView substr(const size_t pos, const size_t count = npos) const {
+        if (pos > length) { throw std::out_of_range("substr position out of range"); }
+        const size_t rest = length - pos;
+        return MyStringView(ptr + pos, count < rest ? count : rest);
+    }
+    void remove_prefix(const size_t count) {
+        ptr += count;
+        length -= count;
+    }
+    void remove_suffix(const size_t count) { length -= count; }
+
+    [[nodiscard]] bool starts_with(const MyStringView prefix) const {
+        return length >= prefix.length && memcmp(ptr, prefix.ptr, prefix.length) == 0;
+    }
+    [[nodiscard]] bool ends_with(const MyStringView suffix) const {
+        return length >= suffix.length && memcmp(ptr + length - suffix.length, suffix.ptr, suffix.length) == 0;
+    }
+
+    // 查找操作，未找到时返回 npos
+    [[nodiscard]] size_t find(const char ch, const size_t pos = 0) const {
+        if (pos >= length) { return npos; }
+        const size_t found = string_search::find_byte(ptr + pos, length - pos, ch);
+        return found == npos ? npos : pos + found;
+    }
+    [[nodiscard]] size_t find(const MyStringView str, const size_t pos = 0) const {
+        if (pos > length) { return npos; }
+        const size_t found = string_search::find(ptr + pos, length - pos, str.ptr, str.length);
+        return found == npos ? npos : pos + found;
+    }
+    // 起始位置不超过 pos 的最后一次出现
+    [[nodiscard]] size_t rfind(const char ch, const size_t pos = npos) const {
+        return string_search::rfind_byte(ptr, pos < length ? pos + 1 : length, ch);
+    }
+    [[nodiscard]] size_t rfind(const MyStringView str, const size_t pos = npos) const {
+        if (str.length > length) { return npos; }
+        const size_t last = pos < length - str.length ? pos : length - str.length;
+        return string_search::rfind(ptr, last + str.length, str.ptr, str.length);
+    }
+    // 第一个属于 / 不属于字符集合 chars 的位置
+    [[nodiscard]] size_t find_first_of(const MyStringView chars, const size_t pos = 0) const {
+        if (pos >= length) { return npos; }
+        const size_t found = string_search::find_first_of(ptr + pos, length - pos, chars.ptr, chars.length);
+        return found == npos ? npos : pos + found;
+    }
+    [[nodiscard]] size_t find_first_not_of(const MyStringView chars, const size_t pos = 0) const {
+        if (pos >= length) { return npos; }
+        const size_t found = string_search::find_first_not_of(ptr + pos, length - pos, chars.ptr, chars.length);
+        return found == npos ? npos : pos + found;
+    }
+    [[nodiscard]] bool contains(const char ch) const { return find(ch) != npos; }
+    [[nodiscard]] bool contains(const MyStringView str) const { return find(str) != npos; }
+
+    // 字典序比较，返回负数、0 或正数
+    [[nodiscard]] int compare(const MyStringView other) const {
+        const size_t min_len = length < other.length ? length : other.length;
+        const int result = min_len == 0 ? 0 : memcmp(ptr, other.ptr, min_len);
+        if (result != 0) { return result; }
+        return length < other.length ? -1 : (length > other.length ? 1 : 0);
+    }
+
+    // 整个视图是合法的数字时写入 value 并返回 true，否则 value 不变。
+    // 规则同 std::from_chars：不跳过空白、不接受 '+'、与 locale 无关，不申请内存
+    template<class T> requires std::is_integral_v<T> && (!std::is_same_v<T, bool>)
+    bool to_int(T& value, const int base = 10) const {
+        T result;
+        const std::from_chars_result parsed = std::from_chars(ptr, ptr + length, result, base);
+        if (parsed.ec != std::errc() || parsed.ptr != ptr + length) { return false; }
+        value = result;
+        return true;
+    }
+    template<class T> requires std::is_floating_point_v<T>
+    bool to_double(T& value) const {
+        T result;
+        const std::from_chars_result parsed = std::from_chars(ptr, ptr + length, result);
+        if (parsed.ec != std::errc() || parsed.ptr != ptr + length) { return false; }
+        value = result;
+        return true;
+    }
+
+    // 惰性切分，见 MyStringSplit
+    [[nodiscard]] MyStringSplit split(char delim) const;
+    [[nodiscard]] MyStringSplit split(MyStringView delim) const;
+    [[nodiscard]] MyStringSplit tokenize(MyStringView delims) const;
+
+    friend std::ostream& operator<<(std::ostream& out, const MyStringView str) {
+        out.write(str.ptr, static_cast<std::streamsize>(str.length));
+        return out;
+    }
+};
+
+// 先比较长度，长度不同时不读取字符
+inline bool operator==(const MyStringView lhs, const MyStringView rhs) {
+    return lhs.size() == rhs.size() && (lhs.size() == 0 || memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+}
+inline bool operator!=(const MyStringView lhs, const MyStringView rhs) { return !(lhs == rhs); }
+// 三路比较：memcmp 比较公共前缀（库实现已向量化），相同则较短的在前；<、>、<=、>= 都由它改写
+inline std::strong_ordering operator<=>(const MyStringView lhs, const MyStringView rhs) { return lhs.compare(rhs) <=> 0; }
+
+// 切分结果的区间，迭代时每次只在剩余部分中找下一个分隔符，产生的字段都是原字符串上的视图，不申请内存。
+// split 按整个分隔串切分并保留空字段（"a,,b" 得到 "a"、""、"b"）；
+// tokenize 以 delims 中任一字符为分隔并跳过空字段
+class MyStringSplit {
+private:
+    MyStringView text;
+    MyStringView delim;
+    char delim_char;   // 单字符分隔符存放在这里，视图在使用时再构造，复制后依然有效
+    bool single;
+    bool any_of;
+
+public:
+    class Iterator {
+    private:
+        MyStringView rest;
+        MyStringView token;
+        MyStringView delim;
+        char delim_char;
+        bool single;
+        bool any_of;
+        bool last;  // 最后一个字段已经取出，下一次前进到末尾
+        bool done;
+
+        [[nodiscard]] MyStringView separator() const { return single ? MyStringView(&delim_char, 1) : delim; }
+
+        void advance() {
+            if (any_of) {
+                const size_t start = rest.find_first_not_of(separator());
+                if (start == MyStringView::npos) {
+                    done = true;
+                    return;
+                }
+                rest.remove_prefix(start);
+                const size_t stop = rest.find_first_of(separator());
+                token = rest.substr(0, stop);
+                rest.remove_prefix(token.size());
+                return;
+            }
+            if (last) {
+                done = true;
+                return;
+            }
+            const MyStringView sep = separator();
+            const size_t stop = sep.is_empty() ? MyStringView::npos : rest.find(sep);
+            if (stop == MyStringView::npos) {
+                token = rest;
+                last = true;
+                return;
+            }
+            token = rest.substr(0, stop);
+            rest.remove_prefix(stop + sep.size());
+        }
+
+    public:
+        Iterator() : delim_char('\0'), single(false), any_of(false), last(true), done(true) {}
+        Iterator(const MyStringView text, const MyStringView delim_, const char delim_char_, const bool single_,
+                 const bool any_of_)
+            : rest(text), delim(delim_), delim_char(delim_char_), single(single_), any_of(any_of_), last(false),
+              done(false) {
+            advance();
+        }
+
+        MyStringView operator*() const { return token; }
+        const MyStringView* operator->() const { return &token; }
+        Iterator& operator++() {
+            advance();
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator temp = *this;
+            advance();
+            return temp;
+        }
+
+        bool operator==(const Iterator& other) const {
+            if (done || other.done) { return done == other.done; }
+            return token.data() == other.token.data() && token.size() == other.token.size();
+        }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    MyStringSplit(const MyStringView text_, const char delim_)
+        : text(text_), delim_char(delim_), single(true), any_of(false) {}
+    MyStringSplit(const MyStringView text_, const MyStringView delim_, const bool any_of_)
+        : text(text_), delim(delim_), delim_char('\0'), single(false), any_of(any_of_) {}
+
+    [[nodiscard]] Iterator begin() const { return Iterator(text, delim, delim_char, single, any_of); }
+    [[nodiscard]] Iterator end() const { return Iterator(); }
+
+    // 依次把字段写入 out，最多 max_count 个，返回写入的个数
+    size_t collect(MyStringView* out, const size_t max_count) const {
+        size_t count = 0;
+        for (Iterator it = begin(); count < max_count && it != end(); ++it) { out[count++] = *it; }
+        return count;
+    }
+};
+
+inline MyStringSplit MyStringView::split(const char delim) const { return MyStringSplit(*this, delim); }
+inline MyStringSplit MyStringView::split(const MyStringView delim) const { return MyStringSplit(*this, delim, false); }
+inline MyStringSplit MyStringView::tokenize(const MyStringView delims) const {
+    return MyStringSplit(*this, delims, true);
+}
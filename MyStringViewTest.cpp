@@ -0,0 +1,175 @@
+// MyStringView 的测试：split / tokenize 的字段与按 std::string 逐步查找得到的结果对照，
+// append_int / append_double 写出的数字经 to_int / to_double 读回后与原值逐位相同
+// 用法：MyStringViewTest [随机轮数]，默认 20000
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Bench.h"
+#include "MyString.h"
+#include "MyStringView.h"
+
+using Fields = std::vector<std::string>;
+
+// 保留空字段；分隔串为空时整个文本是一个字段
+Fields reference_split(const std::string& text, const std::string& delim) {
+    if (delim.empty()) { return {text}; }
+    Fields fields;
+    size_t start = 0;
+    while (true) {
+        const size_t stop = text.find(delim, start);
+        if (stop == std::string::npos) {
+            fields.push_back(text.substr(start));
+            return fields;
+        }
+        fields.push_back(text.substr(start, stop - start));
+        start = stop + delim.size();
+    }
+}
+
+// 以 delims 中任一字符分隔，跳过空字段
+Fields reference_tokenize(const std::string& text, const std::string& delims) {
+    Fields fields;
+    size_t start = text.find_first_not_of(delims);
+    while (start != std::string::npos) {
+        const size_t stop = text.find_first_of(delims, start);
+        fields.push_back(text.substr(start, stop == std::string::npos ? std::string::npos : stop - start));
+        start = stop == std::string::npos ? stop : text.find_first_not_of(delims, stop);
+    }
+    return fields;
+}
+
+// 字段必须是 text 上的视图，并与 expected 逐个相等
+void check_fields(const MyStringView text, const MyStringSplit& split, const Fields& expected) {
+    size_t count = 0;
+    for (const MyStringView field : split) {
+        BENCH_CHECK(count < expected.size());
+        BENCH_CHECK(field == MyStringView(expected[count].data(), expected[count].size()));
+        BENCH_CHECK(field.is_empty() ||
+                    (field.data() >= text.data() && field.data() + field.size() <= text.data() + text.size()));
+        count++;
+    }
+    BENCH_CHECK(count == expected.size());
+}
+
+void check_split(const std::string& text, const std::string& delim) {
+    const MyStringView view(text.data(), text.size());
+    check_fields(view, view.split(MyStringView(delim.data(), delim.size())), reference_split(text, delim));
+    if (delim.size() == 1) { check_fields(view, view.split(delim[0]), reference_split(text, delim)); }
+    check_fields(view, view.tokenize(MyStringView(delim.data(), delim.size())), reference_tokenize(text, delim));
+}
+
+void split_case(const char* text, const char* delim, const Fields& expected) {
+    const MyStringView view(text);
+    check_fields(view, view.split(delim), expected);
+    if (strlen(delim) == 1) { check_fields(view, view.split(delim[0]), expected); }
+}
+
+void tokenize_case(const char* text, const char* delims, const Fields& expected) {
+    const MyStringView view(text);
+    check_fields(view, view.tokenize(delims), expected);
+}
+
+void test_split_cases() {
+    // 空字段、开头和结尾的分隔符、只有分隔符、空文本
+    split_case("a,,b", ",", {"a", "", "b"});
+    split_case(",a,", ",", {"", "a", ""});
+    split_case(",", ",", {"", ""});
+    split_case("", ",", {""});
+    split_case("abc", ",", {"abc"});
+    // 多字符分隔符，包括相邻和自身重叠的情形
+    split_case("a::b::::c", "::", {"a", "b", "", "c"});
+    split_case("::a::", "::", {"", "a", ""});
+    split_case("a:b", "::", {"a:b"});
+    split_case("aaa", "aa", {"", "a"});
+    split_case("a\r\nb\r\n", "\r\n", {"a", "b", ""});
+    // tokenize 跳过所有空字段
+    tokenize_case("  a \t b  ", " \t", {"a", "b"});
+    tokenize_case(" \t ", " \t", {});
+    tokenize_case("", " ", {});
+    tokenize_case("x", " ", {"x"});
+
+    // MyString 转发到视图，collect 最多写入 max_count 个字段
+    const MyString line("id,name,,score,");
+    MyStringView out[8];
+    BENCH_CHECK(line.split(',').collect(out, 8) == 5);
+    BENCH_CHECK(out[0] == "id" && out[1] == "name" && out[2].is_empty() && out[3] == "score" && out[4].is_empty());
+    BENCH_CHECK(line.split(',').collect(out, 2) == 2);
+    BENCH_CHECK(line.tokenize(",").collect(out, 8) == 3);
+    BENCH_CHECK(out[2] == "score");
+}
+
+// 由 a、b 和分隔字符组成的随机文本
+void test_split_random(const size_t rounds) {
+    static constexpr const char* DELIMS[] = {",", ";", ",;", ";;", ",,,", "ab"};
+    bench::Random random;
+    for (size_t round = 0; round < rounds; round++) {
+        std::string text(random.below(40), 'a');
+        for (char& ch : text) { ch = "ab,;"[random.below(4)]; }
+        check_split(text, DELIMS[random.below(sizeof(DELIMS) / sizeof(DELIMS[0]))]);
+    }
+}
+
+template<class T>
+using Bits = std::conditional_t<sizeof(T) == 8, uint64_t, uint32_t>;
+
+// 接在已有内容之后写出，截掉前缀再读回；NaN 只要求读回的仍是 NaN，其余按位比较（区分 -0.0 与 +0.0）
+template<class T>
+void check_round_trip(const T value) {
+    MyString text("x=");
+    text.append_double(value);
+    T parsed = 1;
+    BENCH_CHECK(MyStringView(text).substr(2).to_double(parsed));
+    if (std::isnan(value)) { BENCH_CHECK(std::isnan(parsed)); }
+    else { BENCH_CHECK(std::bit_cast<Bits<T>>(parsed) == std::bit_cast<Bits<T>>(value)); }
+}
+
+template<class T>
+void check_int_round_trip(const T value) {
+    MyString text;
+    text.append_int(value);
+    T parsed = 0;
+    BENCH_CHECK(text.to_int(parsed) && parsed == value);
+}
+
+void test_number_round_trip(const size_t rounds) {
+    for (const double value : {0.0, -0.0, 1.0, -1.5, 0.1, 1e300, std::numeric_limits<double>::denorm_min(),
+                               std::numeric_limits<double>::min(), std::numeric_limits<double>::max(),
+                               std::numeric_limits<double>::lowest(), std::numeric_limits<double>::epsilon(),
+                               std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+                               std::numeric_limits<double>::quiet_NaN()}) {
+        check_round_trip(value);
+        check_round_trip(static_cast<float>(value));
+    }
+    check_int_round_trip(std::numeric_limits<int64_t>::min());
+    check_int_round_trip(std::numeric_limits<int64_t>::max());
+    check_int_round_trip(std::numeric_limits<uint64_t>::max());
+    // 随机位模式覆盖所有指数与非规格化数
+    bench::Random random;
+    for (size_t round = 0; round < rounds; round++) {
+        const uint64_t bits = random();
+        check_round_trip(std::bit_cast<double>(bits));
+        check_round_trip(std::bit_cast<float>(static_cast<uint32_t>(bits)));
+        check_int_round_trip(static_cast<int64_t>(bits));
+        check_int_round_trip(static_cast<int32_t>(bits));
+    }
+    // 不完整或带多余字符的输入返回 false，value 保持不变
+    double value = 2.5;
+    for (const char* bad : {"", " 1", "+1", "1.5x", "1e", "-", "0x10"}) {
+        BENCH_CHECK(!MyStringView(bad).to_double(value) && value == 2.5);
+    }
+}
+
+int main(const int argc, char** argv) {
+    const size_t rounds = bench::arg(argc, argv, 1, 20000);
+    test_split_cases();
+    test_split_random(rounds);
+    test_number_round_trip(rounds);
+    std::puts("ok");
+    return 0;
+}
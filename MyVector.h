@@ -1,15 +1,67 @@
 #pragma once
 #include <cstddef>
+#include <concepts>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "MyAllocator.h"
+#include "VectorOps.h"
 
 
-template<class T>
-class MyVector {
+template<class T, class Alloc = MyAllocator<T>>
+class MyVector : public vector_detail::VectorOps<MyVector<T, Alloc>, T, Alloc> {
 private:
+    using Base = vector_detail::VectorOps<MyVector, T, Alloc>;
+    friend Base;
+    using Traits = std::allocator_traits<Alloc>;
+    using Base::relocate;
+    using Base::distance;
+    using Base::construct_range;
     static constexpr int START_SIZE = 16;
+    // 分配器提供 reallocate(ptr, old_n, new_n)（如 PageAllocator）时，平凡类型的扩缩交给分配器原地完成，不再复制元素
+    static constexpr bool REMAPPABLE = std::is_trivially_copyable_v<T> &&
+        requires(Alloc& a, T* p, size_t n) { { a.reallocate(p, n, n) } -> std::same_as<T*>; };
+    [[no_unique_address]] Alloc alloc;
     size_t size_{};
     size_t capacity_{START_SIZE};
     T* ptr;
 
+    // 只构造 [0, size_) 内的元素，其余槽位保持未初始化
+    void release() {
+        for (size_t i = 0; i < size_; i++) { Traits::destroy(alloc, ptr + i); }
+        if (ptr != nullptr) { Traits::deallocate(alloc, ptr, capacity_); }
+    }
+
+    size_t grow_capacity(const size_t add_capacity) const {
+        if (capacity_ == 0) { return add_capacity > START_SIZE ? add_capacity : START_SIZE; }
+        return capacity_ + (add_capacity > capacity_ ? add_capacity : capacity_);
+    }
+
+    // 释放旧缓冲区并换成 new_ptr，调用前元素必须已经搬走
+    void adopt(T* new_ptr, const size_t new_capacity) {
+        if (ptr != nullptr) { Traits::deallocate(alloc, ptr, capacity_); }
+        ptr = new_ptr;
+        capacity_ = new_capacity;
+    }
+
+    void reallocate(const size_t new_capacity) {
+        if constexpr (REMAPPABLE) {
+            if (ptr != nullptr) {
+                ptr = alloc.reallocate(ptr, capacity_, new_capacity);
+                capacity_ = new_capacity;
+                return;
+            }
+        }
+        T* new_ptr = Traits::allocate(alloc, new_capacity);
+        try { relocate(new_ptr, ptr, size_); }
+        catch (...) {
+            Traits::deallocate(alloc, new_ptr, new_capacity);
+            throw;
+        }
+        adopt(new_ptr, new_capacity);
+    }
+
 public:
     class VectorIterator{
         private:
@@ -39,20 +91,38 @@ public:
         bool operator<=(const VectorIterator& source) const { return ptr <= source.ptr; }
         bool operator>=(const VectorIterator& source) const { return ptr >= source.ptr; }
     };
-    MyVector() : ptr(new T[START_SIZE]) {}
-    explicit MyVector(const size_t num, const T& value = 0) : size_(num) {
+    MyVector() : ptr(Traits::allocate(alloc, START_SIZE)) {}
+    explicit MyVector(const Alloc& alloc_) : alloc(alloc_), ptr(Traits::allocate(alloc, START_SIZE)) {}
+    explicit MyVector(const size_t num, const T& value = T(), const Alloc& alloc_ = Alloc()) : alloc(alloc_), size_(num) {
         capacity_ = START_SIZE;
         while (capacity_ < num) { capacity_ *= 2; }
-        ptr = new T[capacity_];
-        for (size_t i = 0; i < size_; i++) { ptr[i] = value; }
+        ptr = Traits::allocate(alloc, capacity_);
+        for (size_t i = 0; i < size_; i++) { Traits::construct(alloc, ptr + i, value); }
+    }
+    template<class InputIt> requires (!std::is_integral_v<InputIt>)
+    MyVector(InputIt first, InputIt last, const Alloc& alloc_ = Alloc()) : alloc(alloc_) {
+        const size_t num = distance(first, last);
+        capacity_ = START_SIZE;
+        while (capacity_ < num) { capacity_ *= 2; }
+        ptr = Traits::allocate(alloc, capacity_);
+        try { construct_range(ptr, first, num); }
+        catch (...) {
+            Traits::deallocate(alloc, ptr, capacity_);
+            throw;
+        }
+        size_ = num;
     }
-    MyVector(const MyVector& other) {
+    MyVector(const MyVector& other) : alloc(Traits::select_on_container_copy_construction(other.alloc)) {
         capacity_ = other.capacity_;
+        ptr = Traits::allocate(alloc, capacity_);
+        try { construct_range(ptr, other.ptr, other.size_); }
+        catch (...) {
+            Traits::deallocate(alloc, ptr, capacity_);
+            throw;
+        }
         size_ = other.size_;
-        ptr = new T[capacity_];
-        for (size_t i = 0; i < size_; i++) { ptr[i] = other.ptr[i]; }
     }
-    MyVector(MyVector&& other) noexcept {
+    MyVector(MyVector&& other) noexcept : alloc(std::move(other.alloc)) {
         capacity_ = other.capacity_;
         size_ = other.size_;
         ptr = other.ptr;
@@ -62,6 +132,9 @@ public:
     }
 
     MyVector& move(MyVector& other) noexcept {
+        if (this == &other) { return *this; }
+        release();
+        alloc = other.alloc;
         capacity_ = other.capacity_;
         size_ = other.size_;
         ptr = other.ptr;
@@ -71,46 +144,103 @@ public:
         return *this;
     }
 
-    ~MyVector() { delete[] ptr; }
+    ~MyVector() { release(); }
 
     [[nodiscard]] size_t size() const { return size_; }
     [[nodiscard]] size_t capacity() const { return capacity_; }
     [[nodiscard]] bool is_empty() const { return size_ == 0; }
 
+    template<class... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ < capacity_) {
+            Traits::construct(alloc, ptr + size_, std::forward<Args>(args)...);
+            return ptr[size_++];
+        }
+        if constexpr (REMAPPABLE) {
+            T temp(std::forward<Args>(args)...);  // 参数可能引用即将被重映射的元素
+            reallocate(grow_capacity(capacity_));
+            Traits::construct(alloc, ptr + size_, std::move(temp));
+            return ptr[size_++];
+        }
+        // 先在新缓冲区中构造新元素，这样参数引用本容器中的元素时依然有效
+        const size_t new_capacity = grow_capacity(capacity_);
+        T* new_ptr = Traits::allocate(alloc, new_capacity);
+        try { Traits::construct(alloc, new_ptr + size_, std::forward<Args>(args)...); }
+        catch (...) {
+            Traits::deallocate(alloc, new_ptr, new_capacity);
+            throw;
+        }
+        try { relocate(new_ptr, ptr, size_); }
+        catch (...) {
+            Traits::destroy(alloc, new_ptr + size_);
+            Traits::deallocate(alloc, new_ptr, new_capacity);
+            throw;
+        }
+        adopt(new_ptr, new_capacity);
+        return ptr[size_++];
+    }
+    template<class... Args>
+    T& emplace(const size_t index, Args&&... args) {
+        if (index >= size_) { return emplace_back(std::forward<Args>(args)...); }
+        T temp(std::forward<Args>(args)...);  // 先构造，参数可能引用即将被移动的元素
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (size_ >= capacity_) { reallocate(grow_capacity(capacity_)); }
+            memmove(ptr + index + 1, ptr + index, (size_ - index) * sizeof(T));
+            memcpy(ptr + index, &temp, sizeof(T));
+            size_++;
+        }
+        else {
+            // 末尾的新槽位需要构造，其余位置移动赋值后移
+            emplace_back(std::move(ptr[size_ - 1]));
+            for (size_t i = size_ - 2; i > index; i--) { ptr[i] = std::move(ptr[i - 1]); }
+            ptr[index] = std::move(temp);
+        }
+        return ptr[index];
+    }
+
     MyVector& push_back(const T& data) {
-        if (size_ >= capacity_) { reserve(capacity_); }
-        ptr[size_] = data;
-        size_++;
+        emplace_back(data);
+        return *this;
+    }
+    MyVector& push_back(T&& data) {
+        emplace_back(std::move(data));
         return *this;
     }
     void pop_back() {
-        if(size_ > 0) size_--;
-        ptr[size_].~T();
+        if (size_ == 0) return;
+        size_--;
+        Traits::destroy(alloc, ptr + size_);
     }
     MyVector& push_front(const T& data) {
-        if (size_ >= capacity_) { reserve(capacity_); }
-        for(int i = size_; i > 0; i--) { ptr[i] = ptr[i - 1]; }
-        ptr[0] = data;
-        size++;
+        emplace(0, data);
+        return *this;
+    }
+    MyVector& push_front(T&& data) {
+        emplace(0, std::move(data));
         return *this;
     }
     void pop_front() {
-        if(size_ > 0) size_--;
-        for(int i = 0; i < size_; i++) { ptr[i] = ptr[i + 1]; }
+        if (size_ == 0) return;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            memmove(ptr, ptr + 1, (size_ - 1) * sizeof(T));
+            size_--;
+        }
+        else {
+            for (size_t i = 0; i + 1 < size_; i++) { ptr[i] = std::move(ptr[i + 1]); }
+            pop_back();
+        }
     }
     void swap(int index1,int index2) {
         if(index1 != index2) {
-            T temp = ptr[index2];
-            ptr[index2] = ptr[index1];
-            ptr[index1] = temp;
+            T temp = std::move(ptr[index2]);
+            ptr[index2] = std::move(ptr[index1]);
+            ptr[index1] = std::move(temp);
         }
     }
-    void insert(int index, const T& data) {
-        if (size_ >= capacity_) { reserve(capacity_); }
-        for(int i = size_; i > index; i--) { ptr[i] = ptr[i - 1]; }
-        ptr[index] = data;
-        size++;
-    }
+    void insert(int index, const T& data) { emplace(index, data); }
+    void insert(int index, T&& data) { emplace(index, std::move(data)); }
+    // 区间插入、erase、resize、assign 见 VectorOps.h
+    using Base::insert;
 
     T& front() { return *ptr; }
     const T& front() const { return *ptr; }
@@ -119,31 +249,32 @@ public:
 
     [[nodiscard]] bool empty() const { return size_ == 0; }
     void clear() {
-        for (size_t i = 0; i < size_; i++) { ptr[i].~T(); }
+        for (size_t i = 0; i < size_; i++) { Traits::destroy(alloc, ptr + i); }
         size_ = 0;
     }
-    void reserve(const size_t add_capacity) {
-        capacity_ += add_capacity > capacity_ ? add_capacity : capacity_;
-        T* new_ptr = new T[capacity_];
-        for (size_t i = 0; i < size_; i++) { new_ptr[i] = ptr[i]; }
-        delete[] ptr;
-        ptr = new_ptr;
-    }
+    void reserve(const size_t add_capacity) { reallocate(grow_capacity(add_capacity)); }
 
     MyVector& operator=(const MyVector& other) {
         if (this != &other) {
-            delete[] ptr;
-            capacity_ = other.capacity_;
-            size_ = other.size_;
-            ptr = new T[capacity_];
-            for (size_t i = 0; i < size_; i++) { ptr[i] = other.ptr[i]; }
+            // 先用本容器的分配器完整复制一份，分配或构造抛异常时本容器保持不变
+            MyVector copy(other.ptr, other.ptr + other.size_, alloc);
+            move(copy);
         }
         return *this;
     }
+    MyVector& operator=(MyVector&& other) noexcept { return move(other); }
+
+    // 把容量缩减到恰好容纳现有元素
+    void shrink_to_fit() {
+        if (size_ < capacity_) { reallocate(size_); }
+    }
+
+    Alloc get_allocator() const { return alloc; }
 
     VectorIterator begin() const { return VectorIterator(ptr); }
     VectorIterator end() const { return VectorIterator(ptr + size_); }
 
     // Subscript operator
     T& operator[](const size_t index) const { return ptr[index]; }
+    T* data() const { return ptr; }
 };
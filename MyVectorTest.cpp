@@ -0,0 +1,236 @@
+// MyVector / MySmallVector 的测试：扩容与复制的各条路径，以及来源区间位于容器自身中的区间操作，结果与 std::vector 对照
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Bench.h"
+#include "MySmallVector.h"
+#include "MyString.h"
+#include "MyVector.h"
+#include "PageAllocator.h"
+
+template<class T>
+T make(const int i) {
+    if constexpr (std::is_same_v<T, MyString>) { return MyString(std::to_string(i).c_str()); }
+    else { return T(i); }
+}
+
+template<class Vector, class T>
+void check_equal(const Vector& actual, const std::vector<T>& expected) {
+    BENCH_CHECK(actual.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); i++) { BENCH_CHECK(actual[i] == expected[i]); }
+}
+
+// 只能移动的元素：emplace_back 和扩容都只能移动，不能退回复制
+void test_move_only() {
+    MyVector<std::unique_ptr<int>> vector;
+    for (int i = 0; i < 100; i++) { vector.emplace_back(new int(i)); }
+    vector.emplace(0, new int(-1));
+    BENCH_CHECK(vector.size() == 101);
+    for (int i = 0; i < 100; i++) { BENCH_CHECK(*vector[i + 1] == i); }
+    BENCH_CHECK(*vector[0] == -1);
+    MyVector<std::unique_ptr<int>> moved(std::move(vector));
+    BENCH_CHECK(moved.size() == 101 && *moved[100] == 99);
+    vector = std::move(moved);
+    BENCH_CHECK(vector.size() == 101 && *vector[50] == 49);
+}
+
+// 平凡可复制的元素：扩容、复制构造、复制赋值都整块 memcpy
+struct Point {
+    int x;
+    double y;
+};
+
+void test_trivially_copyable() {
+    static_assert(std::is_trivially_copyable_v<Point>);
+    MyVector<Point> vector;
+    for (int i = 0; i < 1000; i++) { vector.push_back(Point{i, i * 0.5}); }
+    MyVector<Point> copy(vector);
+    MyVector<Point> assigned;
+    assigned.push_back(Point{-1, -1});
+    assigned = vector;
+    for (const MyVector<Point>* v : {&vector, &copy, &assigned}) {
+        BENCH_CHECK(v->size() == 1000);
+        for (int i = 0; i < 1000; i++) { BENCH_CHECK((*v)[i].x == i && (*v)[i].y == i * 0.5); }
+    }
+}
+
+// 第 copies_left 次复制时抛异常的元素，live 统计存活对象以发现泄漏
+struct Fragile {
+    static inline int live = 0;
+    static inline int copies_left = -1;
+    int value;
+
+    explicit Fragile(const int value_) : value(value_) { live++; }
+    Fragile(const Fragile& other) : value(other.value) {
+        if (--copies_left == 0) { throw std::runtime_error("copy failed"); }
+        live++;
+    }
+    Fragile& operator=(const Fragile&) = default;
+    ~Fragile() { live--; }
+};
+
+// 复制赋值中途抛异常时，目标容器保持原样且不泄漏
+void test_copy_assign_throws() {
+    {
+        MyVector<Fragile> source;
+        for (int i = 0; i < 40; i++) { source.emplace_back(i); }
+        MyVector<Fragile> target;
+        for (int i = 0; i < 3; i++) { target.emplace_back(-i); }
+        Fragile::copies_left = 20;
+        bool thrown = false;
+        try { target = source; }
+        catch (const std::runtime_error&) { thrown = true; }
+        Fragile::copies_left = -1;
+        BENCH_CHECK(thrown);
+        BENCH_CHECK(target.size() == 3);
+        for (int i = 0; i < 3; i++) { BENCH_CHECK(target[i].value == -i); }
+        target = source;
+        BENCH_CHECK(target.size() == 40 && target[39].value == 39);
+    }
+    BENCH_CHECK(Fragile::live == 0);
+}
+
+// erase 的空区间、反向区间、越界的 last 和整个容器，resize 的缩小、扩大以及引用自身元素的填充值
+template<class Vector, class T>
+void test_erase_resize() {
+    Vector actual;
+    std::vector<T> expected;
+    for (int i = 0; i < 20; i++) {
+        actual.push_back(make<T>(i));
+        expected.push_back(make<T>(i));
+    }
+    actual.erase(5, 5);
+    actual.erase(7, 3);
+    check_equal(actual, expected);
+    actual.erase(3, 8);
+    expected.erase(expected.begin() + 3, expected.begin() + 8);
+    check_equal(actual, expected);
+    actual.erase(actual.size() - 1);
+    expected.pop_back();
+    actual.erase(10, 1000);
+    expected.erase(expected.begin() + 10, expected.end());
+    check_equal(actual, expected);
+
+    actual.resize(4);
+    expected.resize(4);
+    check_equal(actual, expected);
+    actual.resize(30, make<T>(7));
+    expected.resize(30, make<T>(7));
+    check_equal(actual, expected);
+    actual.resize(200, actual[1]);
+    expected.resize(200, expected[1]);
+    check_equal(actual, expected);
+    actual.resize(200);
+    check_equal(actual, expected);
+
+    actual.erase(0, actual.size());
+    expected.clear();
+    check_equal(actual, expected);
+    actual.erase(0, 10);
+    actual.resize(3);
+    expected.resize(3);
+    check_equal(actual, expected);
+}
+
+// 溢出到堆上的 MySmallVector：超过 N 个元素时缩到恰好容纳，不超过 N 个时搬回对象内部
+template<class T>
+void test_small_shrink() {
+    MySmallVector<T, 16> actual;
+    std::vector<T> expected;
+    for (int i = 0; i < 40; i++) {
+        actual.push_back(make<T>(i));
+        expected.push_back(make<T>(i));
+    }
+    actual.shrink_to_fit();
+    BENCH_CHECK(!actual.is_small() && actual.capacity() == 40);
+    check_equal(actual, expected);
+    actual.erase(10, 40);
+    expected.erase(expected.begin() + 10, expected.end());
+    BENCH_CHECK(!actual.is_small());
+    actual.shrink_to_fit();
+    BENCH_CHECK(actual.is_small() && actual.capacity() == 16);
+    check_equal(actual, expected);
+    actual.shrink_to_fit();
+    BENCH_CHECK(actual.is_small());
+    for (int i = 0; i < 20; i++) {
+        actual.push_back(make<T>(-i));
+        expected.push_back(make<T>(-i));
+    }
+    BENCH_CHECK(!actual.is_small());
+    check_equal(actual, expected);
+}
+
+// size 个元素的容器上，把 [from, from + num) 插入到 pos 之前，分别用指针和迭代器作为区间
+template<class Vector, class T>
+void self_insert(const size_t size, const size_t reserve, const size_t pos, const size_t from, const size_t num) {
+    for (const bool by_iterator : {false, true}) {
+        Vector actual;
+        if (reserve > 0) { actual.reserve(reserve); }
+        std::vector<T> expected;
+        for (size_t i = 0; i < size; i++) {
+            actual.push_back(make<T>(static_cast<int>(i)));
+            expected.push_back(make<T>(static_cast<int>(i)));
+        }
+        if (by_iterator) { actual.insert(pos, actual.begin() + from, actual.begin() + from + num); }
+        else { actual.insert(pos, actual.data() + from, actual.data() + from + num); }
+        const std::vector<T> source(expected.begin() + from, expected.begin() + from + num);
+        expected.insert(expected.begin() + pos, source.begin(), source.end());
+        check_equal(actual, expected);
+    }
+}
+
+template<class Vector, class T>
+void test_self_insert() {
+    // 容量足够，不重新分配：区间在插入位置之前、跨过插入位置、在插入位置之后
+    self_insert<Vector, T>(10, 64, 2, 0, 2);
+    self_insert<Vector, T>(10, 64, 2, 1, 5);
+    self_insert<Vector, T>(10, 64, 2, 5, 3);
+    self_insert<Vector, T>(10, 64, 7, 5, 5);
+    self_insert<Vector, T>(10, 64, 0, 0, 10);
+    self_insert<Vector, T>(10, 64, 10, 0, 10);
+    // 需要重新分配
+    self_insert<Vector, T>(10, 0, 3, 2, 8);
+    self_insert<Vector, T>(40, 0, 40, 0, 40);
+}
+
+// 缓冲区由 mremap 扩容时可能整体搬到别处，追加自身必须先复制出来
+void test_remap_self_append() {
+    MyVector<int, PageAllocator<int>> actual;
+    std::vector<int> expected;
+    for (int i = 0; i < 1024; i++) {
+        actual.push_back(i);
+        expected.push_back(i);
+    }
+    for (int round = 0; round < 4; round++) {
+        actual.shrink_to_fit();
+        actual.append(actual.data(), actual.data() + actual.size());
+        expected.insert(expected.end(), expected.begin(), expected.end());
+        check_equal(actual, expected);
+    }
+    actual.insert(100, actual.begin() + 50, actual.end());
+    const std::vector<int> source(expected.begin() + 50, expected.end());
+    expected.insert(expected.begin() + 100, source.begin(), source.end());
+    check_equal(actual, expected);
+}
+
+int main() {
+    test_move_only();
+    test_trivially_copyable();
+    test_copy_assign_throws();
+    test_erase_resize<MyVector<int>, int>();
+    test_erase_resize<MyVector<MyString>, MyString>();
+    test_erase_resize<MySmallVector<int, 16>, int>();
+    test_erase_resize<MySmallVector<MyString, 16>, MyString>();
+    test_small_shrink<int>();
+    test_small_shrink<MyString>();
+    test_self_insert<MyVector<int>, int>();
+    test_self_insert<MyVector<MyString>, MyString>();
+    test_self_insert<MySmallVector<int, 16>, int>();
+    test_self_insert<MySmallVector<MyString, 16>, MyString>();
+    test_self_insert<MyVector<int, PageAllocator<int>>, int>();
+    test_remap_self_append();
+    std::puts("ok");
+    return 0;
+}
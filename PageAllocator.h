@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define PAGE_ALLOCATOR_MMAP 1
+#else
+#define PAGE_ALLOCATOR_MMAP 0
+#endif
+
+// 直接向操作系统按页申请内存的分配器，用于元素数以亿计的 MyVector。
+// 除 allocate / deallocate 外还提供 reallocate：Linux 上用 mremap 扩缩映射，
+// 由内核搬动页表而不是复制数据；缩小时原地解除尾部页的映射，物理内存立即归还。
+// 只有平凡可复制的元素才会走 reallocate，其余类型仍按普通分配器处理。
+template<class T>
+class PageAllocator {
+private:
+    bool huge_pages_;
+
+    static size_t page_size() {
+#if PAGE_ALLOCATOR_MMAP
+        static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+#else
+        return 4096;
+#endif
+    }
+    static size_t round_bytes(const size_t n) {
+        const size_t page = page_size();
+        const size_t bytes = n * sizeof(T);
+        return (bytes + page - 1) / page * page;
+    }
+
+    void advise(void* address, const size_t bytes) const {
+#if PAGE_ALLOCATOR_MMAP && defined(MADV_HUGEPAGE)
+        if (huge_pages_) { madvise(address, bytes, MADV_HUGEPAGE); }
+#else
+        (void)address;
+        (void)bytes;
+#endif
+    }
+
+public:
+    using value_type = T;
+
+    explicit PageAllocator(const bool huge_pages = false) noexcept : huge_pages_(huge_pages) {}
+    template<class U>
+    PageAllocator(const PageAllocator<U>& other) noexcept : huge_pages_(other.huge_pages()) {}
+
+    [[nodiscard]] bool huge_pages() const { return huge_pages_; }
+
+    T* allocate(const size_t n) {
+        const size_t bytes = round_bytes(n > 0 ? n : 1);
+#if PAGE_ALLOCATOR_MMAP
+        void* address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (address == MAP_FAILED) { throw std::bad_alloc(); }
+        advise(address, bytes);
+        return static_cast<T*>(address);
+#else
+        return static_cast<T*>(::operator new(bytes, std::align_val_t(alignof(T))));
+#endif
+    }
+
+    void deallocate(T* ptr, const size_t n) {
+        if (ptr == nullptr) { return; }
+#if PAGE_ALLOCATOR_MMAP
+        munmap(ptr, round_bytes(n > 0 ? n : 1));
+#else
+        ::operator delete(ptr, std::align_val_t(alignof(T)));
+#endif
+    }
+
+    // 把容纳 old_n 个元素的缓冲区调整为容纳 new_n 个元素，前 min(old_n, new_n) 个元素的字节保持不变，
+    // 返回值可能与 ptr 不同
+    T* reallocate(T* ptr, const size_t old_n, const size_t new_n) {
+        const size_t old_bytes = round_bytes(old_n > 0 ? old_n : 1);
+        const size_t new_bytes = round_bytes(new_n > 0 ? new_n : 1);
+        if (old_bytes == new_bytes) { return ptr; }
+#if PAGE_ALLOCATOR_MMAP && defined(__linux__)
+        void* address = mremap(ptr, old_bytes, new_bytes, MREMAP_MAYMOVE);
+        if (address == MAP_FAILED) { throw std::bad_alloc(); }
+        if (new_bytes > old_bytes) { advise(address, new_bytes); }
+        return static_cast<T*>(address);
+#elif PAGE_ALLOCATOR_MMAP
+        if (new_bytes < old_bytes) {
+            munmap(reinterpret_cast<char*>(ptr) + new_bytes, old_bytes - new_bytes);
+            return ptr;
+        }
+        T* new_ptr = allocate(new_n);
+        memcpy(new_ptr, ptr, old_bytes);
+        munmap(ptr, old_bytes);
+        return new_ptr;
+#else
+        T* new_ptr = allocate(new_n);
+        memcpy(new_ptr, ptr, old_bytes < new_bytes ? old_bytes : new_bytes);
+        deallocate(ptr, old_n);
+        return new_ptr;
+#endif
+    }
+
+    template<class U>
+    bool operator==(const PageAllocator<U>& other) const { return huge_pages_ == other.huge_pages(); }
+    template<class U>
+    bool operator!=(const PageAllocator<U>& other) const { return !(*this == other); }
+};
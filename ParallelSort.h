@@ -0,0 +1,181 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include "IntroSort.h"
+#include "MyVector.h"
+
+// 多线程样本排序（sample sort），MySort 的 SortType::parallel 的实现：
+// 1. 随机抽取 OVERSAMPLE * 桶数 个样本排序，等距取出桶数 - 1 个分隔值；
+// 2. 把数据均分给各线程，二分查找每个元素所属的桶并计数；
+// 3. 由计数的前缀和得到每个线程在每个桶中的写入位置，各线程把元素移动到辅助缓冲区，互不冲突；
+// 4. 各线程从共享计数器领取桶，桶内用 intro_sort 排序后移回原数组。
+// 桶数是线程数的 BUCKETS_PER_THREAD 倍，桶大小不均时先做完的线程继续领取剩下的桶。
+// 与某个分隔值相等的元素单独成桶，这种桶不需要排序，因此重复值很多（甚至全部相等）时，
+// 不会把大量元素集中到一个需要排序的桶里
+namespace parallel_sort {
+
+static constexpr size_t BUCKETS_PER_THREAD = 4;
+static constexpr size_t OVERSAMPLE = 32;
+static constexpr size_t THREAD_GRAIN = 1 << 14;  // 每个线程至少分到的元素个数，不足 2 倍时直接单线程排序
+static constexpr size_t MAX_THREADS = 65536 / (2 * BUCKETS_PER_THREAD);  // 桶号用 uint16_t 保存
+
+// 用 threads 个线程（含当前线程）执行 task(0) 到 task(count - 1)，线程从共享计数器领取任务。
+// 任务抛出的第一个异常在全部线程结束后重新抛出
+template<class Task>
+void run_tasks(const size_t threads, const size_t count, Task& task) {
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&] {
+        try {
+            for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+                 i = next.fetch_add(1, std::memory_order_relaxed)) {
+                task(i);
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) { error = std::current_exception(); }
+            next.store(count, std::memory_order_relaxed);
+        }
+    };
+    MyVector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (size_t i = 1; i < threads; i++) { pool.push_back(std::thread(worker)); }
+    worker();
+    for (auto& thread : pool) { thread.join(); }
+    if (error) { std::rethrow_exception(error); }
+}
+
+// 对 [first, last) 按 less 升序排序，不稳定。alloc 用于申请与数据等长的辅助缓冲区
+template<class T, class Less, class Alloc>
+void sort(T* first, T* last, Less less, size_t threads, Alloc alloc) {
+    const size_t size = static_cast<size_t>(last - first);
+    if (threads > size / THREAD_GRAIN) { threads = size / THREAD_GRAIN; }
+    if (threads > MAX_THREADS) { threads = MAX_THREADS; }
+    if (threads <= 1) {
+        intro_sort::sort(first, last, less);
+        return;
+    }
+    const size_t splits = threads * BUCKETS_PER_THREAD - 1;
+    const size_t buckets = 2 * splits + 1;
+
+    // 分隔值：样本位置用 xorshift 伪随机生成，避免等距抽样碰上周期性的输入
+    MyVector<T> sample;
+    sample.reserve((splits + 1) * OVERSAMPLE);
+    uint64_t state = 0x9E3779B97F4A7C15ull ^ size;
+    for (size_t i = 0; i < (splits + 1) * OVERSAMPLE; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        sample.push_back(first[state % size]);
+    }
+    intro_sort::sort(sample.data(), sample.data() + sample.size(), less);
+    MyVector<T> splitters;
+    splitters.reserve(splits);
+    for (size_t i = 1; i <= splits; i++) { splitters.push_back(sample[i * OVERSAMPLE]); }
+    const T* split = splitters.data();
+    // 第 i 个分隔值之前、严格介于相邻分隔值之间的元素属于桶 2i，与第 i 个分隔值相等的元素属于桶 2i + 1。
+    // 相邻分隔值相等时，两者之间的桶是空的
+    auto bucket_of = [&](const T& value) {
+        size_t low = 0;  // 第一个大于 value 的分隔值的下标
+        size_t count = splits;
+        while (count > 0) {
+            const size_t half = count / 2;
+            if (!less(value, split[low + half])) {
+                low += half + 1;
+                count -= half + 1;
+            }
+            else { count = half; }
+        }
+        if (low > 0 && !less(split[low - 1], value)) { return 2 * low - 1; }
+        return 2 * low;
+    };
+    auto is_equal_bucket = [](const size_t b) { return b % 2 == 1; };  // 元素互相等价，不需要排序
+
+    // 第 t 个线程负责 [chunk_begin(t), chunk_begin(t + 1))，offsets[t * buckets + b] 先计数后变为写入位置。
+    // 每个元素的桶号记在 ids 中，之后移动元素时不再比较
+    auto chunk_begin = [&](const size_t t) { return size / threads * t + (t < size % threads ? t : size % threads); };
+    MyVector<size_t> offsets(threads * buckets, 0);
+    const std::unique_ptr<uint16_t[]> ids = std::make_unique_for_overwrite<uint16_t[]>(size);
+    auto count_task = [&](const size_t t) {
+        size_t* count = offsets.data() + t * buckets;
+        for (size_t i = chunk_begin(t); i < chunk_begin(t + 1); i++) {
+            const size_t bucket = bucket_of(first[i]);
+            ids[i] = static_cast<uint16_t>(bucket);
+            count[bucket]++;
+        }
+    };
+    run_tasks(threads, threads, count_task);
+
+    MyVector<size_t> bucket_begin(buckets + 1, 0);
+    size_t sum = 0;
+    for (size_t b = 0; b < buckets; b++) {
+        bucket_begin[b] = sum;
+        for (size_t t = 0; t < threads; t++) {
+            const size_t count = offsets[t * buckets + b];
+            offsets[t * buckets + b] = sum;
+            sum += count;
+        }
+    }
+    bucket_begin[buckets] = sum;
+
+    using Traits = std::allocator_traits<Alloc>;
+    T* buffer = Traits::allocate(alloc, size);
+    auto scatter_task = [&](const size_t t) {
+        size_t* offset = offsets.data() + t * buckets;
+        for (size_t i = chunk_begin(t); i < chunk_begin(t + 1); i++) {
+            ::new (static_cast<void*>(buffer + offset[ids[i]]++)) T(std::move(first[i]));
+        }
+    };
+    run_tasks(threads, threads, scatter_task);
+
+    // 每个任务排序一个桶并移回原数组。相等桶不需要排序，按 THREAD_GRAIN 切成多段并行移回，
+    // 大量重复值集中在一个桶里时也不会由单个线程完成
+    struct Range {
+        size_t begin;
+        size_t end;
+        bool sort;
+    };
+    MyVector<Range> ranges;
+    for (size_t b = 0; b < buckets; b++) {
+        if (!is_equal_bucket(b)) { ranges.push_back(Range{bucket_begin[b], bucket_begin[b + 1], true}); }
+        else {
+            for (size_t begin = bucket_begin[b]; begin < bucket_begin[b + 1]; begin += THREAD_GRAIN) {
+                const size_t end = begin + THREAD_GRAIN < bucket_begin[b + 1] ? begin + THREAD_GRAIN : bucket_begin[b + 1];
+                ranges.push_back(Range{begin, end, false});
+            }
+        }
+    }
+    // 比较抛出异常时，没有完成的任务的元素仍在 buffer 中，销毁后再释放；此时 data 的内容未定义
+    const std::unique_ptr<bool[]> done = std::make_unique<bool[]>(ranges.size());
+    auto range_task = [&](const size_t r) {
+        T* begin = buffer + ranges[r].begin;
+        T* end = buffer + ranges[r].end;
+        if (ranges[r].sort) { intro_sort::sort(begin, end, less); }
+        T* out = first + ranges[r].begin;
+        for (T* it = begin; it != end; ++it, ++out) {
+            *out = std::move(*it);
+            it->~T();
+        }
+        done[r] = true;
+    };
+    try { run_tasks(threads, ranges.size(), range_task); }
+    catch (...) {
+        for (size_t r = 0; r < ranges.size(); r++) {
+            if (!done[r]) { std::destroy(buffer + ranges[r].begin, buffer + ranges[r].end); }
+        }
+        Traits::deallocate(alloc, buffer, size);
+        throw;
+    }
+    Traits::deallocate(alloc, buffer, size);
+}
+
+}  // namespace parallel_sort
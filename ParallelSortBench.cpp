@@ -0,0 +1,58 @@
+// SortType::parallel 随线程数的扩展性，以单线程的 SortType::quick 为参照，每次都核对排序结果。
+// 用法：ParallelSortBench [元素个数] [最大线程数]，默认 10000000 个，线程数从 1 倍增到硬件线程数与 8 中的较大者
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "Bench.h"
+#include "MySort.h"
+#include "MyVector.h"
+
+struct Pattern {
+    const char* name;
+    int (*make)(size_t i, bench::Random& random);
+};
+
+static constexpr Pattern PATTERNS[] = {
+    {"random", [](size_t, bench::Random& random) { return static_cast<int>(random()); }},
+    {"sorted", [](size_t i, bench::Random&) { return static_cast<int>(i); }},
+    {"few unique", [](size_t, bench::Random& random) { return static_cast<int>(random.below(4)); }},
+    {"all equal", [](size_t, bench::Random&) { return 7; }},
+};
+
+int main(const int argc, char** argv) {
+    const size_t size = bench::arg(argc, argv, 1, 10000000);
+    const size_t hardware = std::thread::hardware_concurrency();
+    const size_t max_threads = bench::arg(argc, argv, 2, std::max<size_t>(hardware, 8));
+    std::printf("%zu ints, %zu hardware threads, ms (best of 3) and speedup over 1 thread\n", size, hardware);
+    std::printf("%-12s %10s", "pattern", "quick");
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) { std::printf("  %7zu thr", threads); }
+    std::printf("\n");
+
+    for (const Pattern& pattern : PATTERNS) {
+        bench::Random random;
+        std::vector<int> input(size);
+        for (size_t i = 0; i < size; i++) { input[i] = pattern.make(i, random); }
+        std::vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+
+        MyVector<int> data;
+        auto run = [&](const MySort& sort) {
+            const double ms = bench::best_ms(3, [&] { data.assign(input.data(), input.data() + size); },
+                                             [&] { sort(data); });
+            BENCH_CHECK(data.size() == size);
+            for (size_t i = 0; i < size; i++) { BENCH_CHECK(data[i] == expected[i]); }
+            return ms;
+        };
+        std::printf("%-12s %10.2f", pattern.name, run(MySort(SortType::quick)));
+        double base = 0;
+        for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+            const double ms = run(MySort(SortType::parallel, threads));
+            if (threads == 1) { base = ms; }
+            std::printf("  %6.1f x%-4.1f", ms, base / ms);
+            std::fflush(stdout);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "IntroSort.h"
+
+// 按字节（基数 256）从低位到高位的 LSD 基数排序，稳定，MySort 的 SortType::radix 的实现。
+// 键由投影 proj(元素) 得到，可以是任意宽度的有符号/无符号整数、float 或 double：
+// 先映射为同宽度的无符号整数，使无符号比较的顺序与原来的顺序一致，再逐字节分配。
+// 一趟遍历统计所有字节的直方图，所有键在某个字节上相同时跳过这一趟；
+// 数据在原数组与一块辅助缓冲区之间来回移动，最后结果不在原数组时再移回
+namespace radix_sort {
+
+static constexpr ptrdiff_t SMALL_RADIX = 64;  // 更短时用插入排序
+
+template<class Key>
+concept RadixKey = std::is_integral_v<Key> || std::is_same_v<Key, float> || std::is_same_v<Key, double>;
+
+// 有符号整数翻转符号位；浮点数为负时翻转全部位，否则只翻转符号位，得到 -inf < ... < -0.0 < +0.0 < ... < +inf，
+// NaN 按符号位排在两端
+template<RadixKey Key>
+auto key_bits(const Key key) {
+    if constexpr (std::is_floating_point_v<Key>) {
+        using Bits = std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>;
+        constexpr Bits SIGN = Bits(1) << (sizeof(Bits) * 8 - 1);
+        const Bits bits = std::bit_cast<Bits>(key);
+        return (bits & SIGN) != 0 ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | SIGN);
+    }
+    else if constexpr (std::is_same_v<Key, bool>) { return static_cast<uint8_t>(key); }
+    else {
+        using Bits = std::make_unsigned_t<Key>;
+        Bits bits = static_cast<Bits>(key);
+        if constexpr (std::is_signed_v<Key>) { bits ^= Bits(1) << (sizeof(Bits) * 8 - 1); }
+        return bits;
+    }
+}
+
+// 对 [first, last) 按 proj(元素) 升序排序，键相等的元素保持原来的相对顺序。alloc 用于申请辅助缓冲区
+template<class T, class Proj, class Alloc>
+    requires RadixKey<std::remove_cvref_t<std::invoke_result_t<Proj&, const T&>>>
+void sort(T* first, T* last, Proj proj, Alloc alloc) {
+    using Key = std::remove_cvref_t<std::invoke_result_t<Proj&, const T&>>;
+    constexpr size_t BYTES = sizeof(key_bits(Key()));
+    const ptrdiff_t size = last - first;
+    auto bits_of = [&](const T& value) { return key_bits(static_cast<Key>(proj(value))); };
+
+    if (size < SMALL_RADIX) {
+        auto less = [&](const T& lhs, const T& rhs) { return bits_of(lhs) < bits_of(rhs); };
+        intro_sort::insertion_sort(first, last, less);
+        return;
+    }
+
+    size_t counts[BYTES][256];
+    memset(counts, 0, sizeof(counts));
+    for (const T* it = first; it != last; ++it) {
+        const auto bits = bits_of(*it);
+        for (size_t byte = 0; byte < BYTES; byte++) { counts[byte][(bits >> (byte * 8)) & 0xFF]++; }
+    }
+
+    using Traits = std::allocator_traits<Alloc>;
+    T* buffer = Traits::allocate(alloc, size);
+    bool constructed = false;  // buffer 中的元素是否已构造
+    T* from = first;
+    T* to = buffer;
+    for (size_t byte = 0; byte < BYTES; byte++) {
+        size_t* count = counts[byte];
+        const auto first_bits = bits_of(*from);
+        if (count[(first_bits >> (byte * 8)) & 0xFF] == static_cast<size_t>(size)) { continue; }
+
+        size_t sum = 0;
+        for (size_t digit = 0; digit < 256; digit++) {
+            const size_t temp = count[digit];
+            count[digit] = sum;
+            sum += temp;
+        }
+        if (to == buffer && !constructed) {
+            for (T* it = from; it != from + size; ++it) {
+                ::new (static_cast<void*>(to + count[(bits_of(*it) >> (byte * 8)) & 0xFF]++)) T(std::move(*it));
+            }
+            constructed = true;
+        }
+        else {
+            for (T* it = from; it != from + size; ++it) { to[count[(bits_of(*it) >> (byte * 8)) & 0xFF]++] = std::move(*it); }
+        }
+        std::swap(from, to);
+    }
+
+    if (from == buffer) { std::move(buffer, buffer + size, first); }
+    if (constructed) { std::destroy(buffer, buffer + size); }
+    Traits::deallocate(alloc, buffer, size);
+}
+
+}  // namespace radix_sort
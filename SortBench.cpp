@@ -0,0 +1,66 @@
+// MySort 各算法在对抗性输入上的耗时，以 std::sort 为参照，每次都核对排序结果。
+// 用法：SortBench [元素个数]，默认 1000000
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include "Bench.h"
+#include "MySort.h"
+#include "MyVector.h"
+
+struct Pattern {
+    const char* name;
+    int (*make)(size_t i, size_t size, bench::Random& random);
+};
+
+static constexpr Pattern PATTERNS[] = {
+    {"random", [](size_t, size_t, bench::Random& random) { return static_cast<int>(random()); }},
+    {"sorted", [](size_t i, size_t, bench::Random&) { return static_cast<int>(i); }},
+    {"reverse", [](size_t i, size_t size, bench::Random&) { return static_cast<int>(size - i); }},
+    {"organ pipe", [](size_t i, size_t size, bench::Random&) { return static_cast<int>(i < size / 2 ? i : size - i); }},
+    {"few unique", [](size_t, size_t, bench::Random& random) { return static_cast<int>(random.below(4)); }},
+    {"all equal", [](size_t, size_t, bench::Random&) { return 7; }},
+    {"sawtooth", [](size_t i, size_t size, bench::Random&) { return static_cast<int>(i % 2 ? i : size - i); }},
+    {"nearly sorted", [](size_t i, size_t, bench::Random& random) {
+        return static_cast<int>(random.below(100) == 0 ? random() : i);
+    }},
+};
+
+struct Algorithm {
+    const char* name;
+    int type;
+};
+
+static constexpr Algorithm ALGORITHMS[] = {
+    {"quick", SortType::quick}, {"heap", SortType::heap},   {"merge", SortType::merge},
+    {"shell", SortType::shell}, {"radix", SortType::radix}, {"parallel", SortType::parallel},
+};
+
+int main(const int argc, char** argv) {
+    const size_t size = bench::arg(argc, argv, 1, 1000000);
+    std::printf("%zu ints, ms (best of 3)\n%-14s", size, "pattern");
+    for (const Algorithm& algorithm : ALGORITHMS) { std::printf("%10s", algorithm.name); }
+    std::printf("%10s\n", "std::sort");
+
+    for (const Pattern& pattern : PATTERNS) {
+        bench::Random random;
+        std::vector<int> input(size);
+        for (size_t i = 0; i < size; i++) { input[i] = pattern.make(i, size, random); }
+        std::vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+        std::printf("%-14s", pattern.name);
+
+        MyVector<int> data;
+        for (const Algorithm& algorithm : ALGORITHMS) {
+            const MySort sort(algorithm.type);
+            const double ms = bench::best_ms(3, [&] { data.assign(input.data(), input.data() + size); },
+                                             [&] { sort(data); });
+            std::printf("%10.2f", ms);
+            std::fflush(stdout);
+            BENCH_CHECK(data.size() == size);
+            for (size_t i = 0; i < size; i++) { BENCH_CHECK(data[i] == expected[i]); }
+        }
+        std::vector<int> copy;
+        std::printf("%10.2f\n", bench::best_ms(3, [&] { copy = input; }, [&] { std::sort(copy.begin(), copy.end()); }));
+    }
+    return 0;
+}
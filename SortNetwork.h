@@ -0,0 +1,161 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "MySimd.h"
+
+// 小数组的向量化双调排序网络（bitonic sort），作为 intro_sort 与 MySort::merge 的基础情形。
+// 不超过 MAX_SIZE 个元素补上最大值凑满 MAX_SIZE 个，整体装进寄存器，用固定的比较交换序列排序，没有数据相关的分支。
+// 跨寄存器的比较交换直接对两个寄存器取 min / max，同一寄存器内的先用 __builtin_shufflevector 取出配对的元素。
+// 只支持 32 / 64 位的整数和浮点数：浮点数按位解释为有符号整数，负数再翻转除符号位以外的位，
+// 整数的大小顺序就与浮点数一致。与 SurfVectorBatch 相同，按寄存器宽度实例化为 SSE2 / AVX2 / AVX-512 三个版本，
+// 运行时选用 CPU 支持的最宽版本；不支持向量扩展的编译器退化为插入排序
+namespace sort_network {
+
+static constexpr int MAX_SIZE = 32;
+
+template<class T>
+concept NetworkKey = (std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) == 4 || sizeof(T) == 8)) ||
+                     std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+#if defined(__GNUC__)
+#define SORT_NETWORK_INLINE [[gnu::always_inline]] inline
+
+// 排序时实际比较的整数类型
+template<class T>
+using KeyOf = std::conditional_t<std::is_same_v<T, float>, int32_t,
+                                 std::conditional_t<std::is_same_v<T, double>, int64_t, T>>;
+
+// 一个寄存器容纳 W 个键，R 个寄存器合起来是网络的大小 N 个
+template<class Key, int BYTES, int SIZE>
+struct Lanes {
+    using Reg [[gnu::vector_size(BYTES)]] = Key;
+    using Mask [[gnu::vector_size(BYTES)]] = std::make_signed_t<Key>;
+    using Element = Key;
+    static constexpr int N = SIZE;
+    static constexpr int W = BYTES / sizeof(Key);
+    static constexpr int R = N / W;
+};
+
+// 双调排序的一步：第 g 个与第 g ^ J 个元素比较交换，(g & K) == 0 时较小者在前，否则较大者在前。
+// 寄存器下标 r 也作为模板参数展开，选择较小者还是较大者的掩码都是编译期常量。
+// J 小于寄存器宽度时配对的元素在同一寄存器 r 内
+template<class L, int K, int J, int r, size_t... I>
+SORT_NETWORK_INLINE void exchange_in_register(typename L::Reg& reg, std::index_sequence<I...>) {
+    using Reg = typename L::Reg;
+    using Mask = typename L::Mask;
+    using Signed = std::make_signed_t<typename L::Element>;
+    constexpr Mask TAKE_LOW = {
+        static_cast<Signed>((((r * L::W + static_cast<int>(I)) & K) == 0) == ((static_cast<int>(I) & J) == 0) ? -1 : 0)...};
+    const Reg other = __builtin_shufflevector(reg, reg, (I ^ J)...);
+    const Reg low = reg < other ? reg : other;
+    const Reg high = reg < other ? other : reg;
+    reg = TAKE_LOW != 0 ? low : high;
+}
+// 否则与寄存器 r + J / W 中对应的元素配对，r 是两者中较小的下标
+template<class L, int K, int J, int r>
+SORT_NETWORK_INLINE void exchange_across(typename L::Reg* regs) {
+    using Reg = typename L::Reg;
+    constexpr int D = J / L::W;
+    if constexpr ((r & D) == 0) {
+        const Reg a = regs[r];
+        const Reg b = regs[r + D];
+        const Reg low = a < b ? a : b;
+        const Reg high = a < b ? b : a;
+        constexpr bool ASCENDING = ((r * L::W) & K) == 0;
+        regs[r] = ASCENDING ? low : high;
+        regs[r + D] = ASCENDING ? high : low;
+    }
+}
+
+template<class L, int K, int J, int... r>
+SORT_NETWORK_INLINE void merge_steps(typename L::Reg* regs, std::integer_sequence<int, r...> sequence) {
+    if constexpr (J >= L::W) { (exchange_across<L, K, J, r>(regs), ...); }
+    else { (exchange_in_register<L, K, J, r>(regs[r], std::make_index_sequence<L::W>()), ...); }
+    if constexpr (J > 1) { merge_steps<L, K, J / 2>(regs, sequence); }
+}
+template<class L, int K = 2>
+SORT_NETWORK_INLINE void bitonic(typename L::Reg* regs) {
+    merge_steps<L, K, K / 2>(regs, std::make_integer_sequence<int, L::R>());
+    if constexpr (K < L::N) { bitonic<L, K * 2>(regs); }
+}
+
+// 浮点数的位与有符号整数顺序之间的变换，变换两次还原
+template<class L>
+SORT_NETWORK_INLINE void flip_negative(typename L::Reg* regs) {
+    using Key = typename L::Element;
+    for (int r = 0; r < L::R; r++) {
+        regs[r] ^= (regs[r] >> (sizeof(Key) * 8 - 1)) & std::numeric_limits<Key>::max();
+    }
+}
+
+template<class L, class T>
+SORT_NETWORK_INLINE void sort_kernel(T* data, const size_t size) {
+    using Key = KeyOf<T>;
+    Key keys[L::N];
+    for (size_t i = size; i < L::N; i++) { keys[i] = std::numeric_limits<Key>::max(); }
+    memcpy(keys, data, size * sizeof(T));
+    typename L::Reg regs[L::R];
+    memcpy(regs, keys, sizeof(keys));
+    if constexpr (std::is_floating_point_v<T>) { flip_negative<L>(regs); }
+    bitonic<L>(regs);
+    if constexpr (std::is_floating_point_v<T>) { flip_negative<L>(regs); }
+    memcpy(keys, regs, sizeof(keys));
+    memcpy(data, keys, size * sizeof(T));
+}
+
+// 网络的代价只取决于大小，按 size 选用 8 / 16 / 32 中够用的最小网络，至少占满一个寄存器
+template<int BYTES, class T>
+SORT_NETWORK_INLINE void sort_width(T* data, const size_t size) {
+    using Key = KeyOf<T>;
+    constexpr int W = BYTES / sizeof(Key);
+    if constexpr (W <= 8) {
+        if (size <= 8) { return sort_kernel<Lanes<Key, BYTES, 8>>(data, size); }
+    }
+    if constexpr (W <= 16) {
+        if (size <= 16) { return sort_kernel<Lanes<Key, BYTES, 16>>(data, size); }
+    }
+    sort_kernel<Lanes<Key, BYTES, MAX_SIZE>>(data, size);
+}
+
+#if MY_SIMD_X86
+template<class T>
+__attribute__((target("avx512f"))) void sort_avx512(T* data, const size_t size) { sort_width<64>(data, size); }
+template<class T>
+__attribute__((target("avx2"))) void sort_avx2(T* data, const size_t size) { sort_width<32>(data, size); }
+template<class T>
+__attribute__((target("sse2"))) void sort_sse2(T* data, const size_t size) { sort_width<16>(data, size); }
+#endif
+
+// 升序排序 data 的前 size 个元素，要求 size <= MAX_SIZE
+template<NetworkKey T>
+void sort(T* data, const size_t size) {
+    if (size < 2) { return; }
+#if MY_SIMD_X86
+    switch (my_simd::isa()) {
+        case my_simd::Isa::AVX512: sort_avx512(data, size); return;
+        case my_simd::Isa::AVX2: sort_avx2(data, size); return;
+        case my_simd::Isa::SSE2: sort_sse2(data, size); return;
+        default: sort_width<16>(data, size); return;
+    }
+#else
+    sort_width<16>(data, size);
+#endif
+}
+#else
+// 没有向量扩展时的标量版本：插入排序
+template<NetworkKey T>
+void sort(T* data, const size_t size) {
+    for (size_t i = 1; i < size; i++) {
+        const T key = data[i];
+        size_t j = i;
+        for (; j > 0 && key < data[j - 1]; --j) { data[j] = data[j - 1]; }
+        data[j] = key;
+    }
+}
+#endif
+
+}  // namespace sort_network
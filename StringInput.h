@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <streambuf>
+
+namespace string_input {
+
+// 通过成员指针访问 streambuf 受保护的读缓冲区：在派生类中取得的是基类成员指针，可以作用于任意 streambuf
+struct BufferAccess : std::streambuf {
+    static char* begin(std::streambuf* buf) { return (buf->*&BufferAccess::gptr)(); }
+    static char* end(std::streambuf* buf) { return (buf->*&BufferAccess::egptr)(); }
+    static void bump(std::streambuf* buf, const int count) { (buf->*&BufferAccess::gbump)(count); }
+};
+
+// 按块读取 streambuf：peek 返回读缓冲区中现有的全部字节，consume 确认用掉其中一部分。
+// 没有读缓冲区的 streambuf 退化为每次一个字节
+class StreamChunks {
+private:
+    std::streambuf* buf;
+    char single;
+    bool unbuffered = false;
+
+public:
+    explicit StreamChunks(std::streambuf* buf_) : buf(buf_), single('\0') {}
+
+    // 流结束时返回 false
+    bool peek(const char*& data, size_t& count) {
+        char* begin = BufferAccess::begin(buf);
+        char* end = BufferAccess::end(buf);
+        if (begin == end) {
+            const int ch = buf->sgetc();  // 触发 underflow 填充缓冲区
+            if (ch == std::streambuf::traits_type::eof()) { return false; }
+            begin = BufferAccess::begin(buf);
+            end = BufferAccess::end(buf);
+            if (begin == end) {
+                single = std::streambuf::traits_type::to_char_type(ch);
+                unbuffered = true;
+                data = &single;
+                count = 1;
+                return true;
+            }
+        }
+        unbuffered = false;
+        data = begin;
+        count = static_cast<size_t>(end - begin);
+        return true;
+    }
+
+    // count 不超过最近一次 peek 返回的长度
+    void consume(const size_t count) {
+        if (count == 0) { return; }
+        if (unbuffered) { buf->sbumpc(); }
+        else { BufferAccess::bump(buf, static_cast<int>(count)); }
+    }
+};
+
+}  // namespace string_input
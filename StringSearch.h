@@ -0,0 +1,341 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "MySimd.h"
+#if MY_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// MyString 查找操作的底层实现，全部作用在 (指针, 长度) 上，不申请内存。
+// 字节扫描按 SSE2 / AVX2 分派；子串查找先用首尾字节做向量过滤，
+// 候选验证的代价超过扫描长度的常数倍时改用 Two-Way 算法，保证最坏情况线性
+namespace string_search {
+
+constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+// 字符集合不超过 SET_SIMD_MAX 个时逐个向量比较，否则查 256 位的位图
+constexpr size_t SET_SIMD_MAX = 8;
+// 向量过滤阶段允许的验证字节数：已扫描长度的 VERIFY_FACTOR 倍再加 VERIFY_SLACK
+constexpr size_t VERIFY_FACTOR = 4;
+constexpr size_t VERIFY_SLACK = 256;
+
+struct ByteSet {
+    uint64_t bits[4] = {};
+
+    ByteSet(const char* set, const size_t m) {
+        for (size_t i = 0; i < m; i++) { add(static_cast<unsigned char>(set[i])); }
+    }
+    void add(const unsigned char ch) { bits[ch >> 6] |= uint64_t(1) << (ch & 63); }
+    [[nodiscard]] bool contains(const unsigned char ch) const { return bits[ch >> 6] >> (ch & 63) & 1; }
+};
+
+// 在 [p, p + n) 中找第一个属于（EXCLUDE 时不属于）set 的字节
+template<bool EXCLUDE>
+size_t scan_scalar(const char* p, const size_t n, const char* set, const size_t m) {
+    const ByteSet table(set, m);
+    for (size_t i = 0; i < n; i++) {
+        if (table.contains(static_cast<unsigned char>(p[i])) != EXCLUDE) { return i; }
+    }
+    return NOT_FOUND;
+}
+
+#if MY_SIMD_X86
+template<bool EXCLUDE>
+__attribute__((target("sse2"))) size_t scan_sse2(const char* p, const size_t n, const char* set, const size_t m) {
+    __m128i needles[SET_SIMD_MAX];
+    for (size_t k = 0; k < m; k++) { needles[k] = _mm_set1_epi8(set[k]); }
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i hit = _mm_cmpeq_epi8(block, needles[0]);
+        for (size_t k = 1; k < m; k++) { hit = _mm_or_si128(hit, _mm_cmpeq_epi8(block, needles[k])); }
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hit));
+        if constexpr (EXCLUDE) { mask ^= 0xFFFF; }
+        if (mask != 0) { return i + __builtin_ctz(mask); }
+    }
+    const size_t rest = scan_scalar<EXCLUDE>(p + i, n - i, set, m);
+    return rest == NOT_FOUND ? NOT_FOUND : i + rest;
+}
+
+template<bool EXCLUDE>
+__attribute__((target("avx2"))) size_t scan_avx2(const char* p, const size_t n, const char* set, const size_t m) {
+    __m256i needles[SET_SIMD_MAX];
+    for (size_t k = 0; k < m; k++) { needles[k] = _mm256_set1_epi8(set[k]); }
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i hit = _mm256_cmpeq_epi8(block, needles[0]);
+        for (size_t k = 1; k < m; k++) { hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(block, needles[k])); }
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+        if constexpr (EXCLUDE) { mask = ~mask; }
+        if (mask != 0) { return i + __builtin_ctz(mask); }
+    }
+    const size_t rest = scan_sse2<EXCLUDE>(p + i, n - i, set, m);
+    return rest == NOT_FOUND ? NOT_FOUND : i + rest;
+}
+
+// 从后往前找最后一个等于 ch 的字节
+__attribute__((target("sse2"))) inline size_t rscan_sse2(const char* p, size_t n, const char ch) {
+    const __m128i needle = _mm_set1_epi8(ch);
+    for (; n >= 16; n -= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + n - 16));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+        if (mask != 0) { return n - 16 + (31 - __builtin_clz(mask)); }
+    }
+    while (n > 0) {
+        if (p[--n] == ch) { return n; }
+    }
+    return NOT_FOUND;
+}
+
+__attribute__((target("avx2"))) inline size_t rscan_avx2(const char* p, size_t n, const char ch) {
+    const __m256i needle = _mm256_set1_epi8(ch);
+    for (; n >= 32; n -= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + n - 32));
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        if (mask != 0) { return n - 32 + (31 - __builtin_clz(mask)); }
+    }
+    return rscan_sse2(p, n, ch);
+}
+#endif
+
+template<bool EXCLUDE>
+size_t scan(const char* p, const size_t n, const char* set, const size_t m) {
+#if MY_SIMD_X86
+    if (m > 0 && m <= SET_SIMD_MAX) {
+        switch (my_simd::isa()) {
+            case my_simd::Isa::AVX512:
+            case my_simd::Isa::AVX2: return scan_avx2<EXCLUDE>(p, n, set, m);
+            case my_simd::Isa::SSE2: return scan_sse2<EXCLUDE>(p, n, set, m);
+            default: break;
+        }
+    }
+#endif
+    return scan_scalar<EXCLUDE>(p, n, set, m);
+}
+
+inline size_t find_byte(const char* p, const size_t n, const char ch) {
+#if MY_SIMD_X86
+    return scan<false>(p, n, &ch, 1);
+#else
+    const void* hit = memchr(p, ch, n);
+    return hit == nullptr ? NOT_FOUND : static_cast<size_t>(static_cast<const char*>(hit) - p);
+#endif
+}
+inline size_t find_first_of(const char* p, const size_t n, const char* set, const size_t m) {
+    return scan<false>(p, n, set, m);
+}
+inline size_t find_first_not_of(const char* p, const size_t n, const char* set, const size_t m) {
+    return scan<true>(p, n, set, m);
+}
+
+inline size_t rfind_byte(const char* p, size_t n, const char ch) {
+#if MY_SIMD_X86
+    switch (my_simd::isa()) {
+        case my_simd::Isa::AVX512:
+        case my_simd::Isa::AVX2: return rscan_avx2(p, n, ch);
+        case my_simd::Isa::SSE2: return rscan_sse2(p, n, ch);
+        default: break;
+    }
+#endif
+    while (n > 0) {
+        if (p[--n] == ch) { return n; }
+    }
+    return NOT_FOUND;
+}
+
+// 正向与反向读取文本，反向时 Two-Way 在倒序的文本中查找倒序的模式串，用于 rfind
+struct Forward {
+    const unsigned char* p;
+    unsigned char operator[](const size_t i) const { return p[i]; }
+};
+struct Backward {
+    const unsigned char* end;
+    unsigned char operator[](const size_t i) const { return end[-1 - static_cast<ptrdiff_t>(i)]; }
+};
+
+// 模式串的临界分解：返回分解位置，period 为对应的周期
+template<class Text>
+size_t critical_factorization(const Text& needle, const size_t m, size_t& period) {
+    size_t max_suffix = NOT_FOUND, j = 0, k = 1, p = 1;
+    while (j + k < m) {
+        const unsigned char a = needle[j + k], b = needle[max_suffix + k];
+        if (a < b) {
+            j += k;
+            k = 1;
+            p = j - max_suffix;
+        }
+        else if (a == b) {
+            if (k != p) { k++; }
+            else {
+                j += p;
+                k = 1;
+            }
+        }
+        else {
+            max_suffix = j++;
+            k = p = 1;
+        }
+    }
+    period = p;
+
+    size_t max_suffix_rev = NOT_FOUND;
+    j = 0;
+    k = p = 1;
+    while (j + k < m) {
+        const unsigned char a = needle[j + k], b = needle[max_suffix_rev + k];
+        if (b < a) {
+            j += k;
+            k = 1;
+            p = j - max_suffix_rev;
+        }
+        else if (a == b) {
+            if (k != p) { k++; }
+            else {
+                j += p;
+                k = 1;
+            }
+        }
+        else {
+            max_suffix_rev = j++;
+            k = p = 1;
+        }
+    }
+    if (max_suffix_rev + 1 < max_suffix + 1) { return max_suffix + 1; }
+    period = p;
+    return max_suffix_rev + 1;
+}
+
+// Crochemore-Perrin Two-Way 算法，O(n + m) 时间、O(1) 空间，要求 m > 0
+template<class Text>
+size_t two_way(const Text& hay, const size_t n, const Text& needle, const size_t m) {
+    if (m > n) { return NOT_FOUND; }
+    size_t period;
+    const size_t suffix = critical_factorization(needle, m, period);
+
+    bool periodic = period + suffix <= m;
+    for (size_t i = 0; periodic && i < suffix; i++) { periodic = needle[i] == needle[i + period]; }
+
+    size_t j = 0;
+    if (periodic) {
+        // 模式串整体具有周期 period，失配时只能按周期移动，memory 记录右半部分已经匹配的长度
+        size_t memory = 0;
+        while (j + m <= n) {
+            size_t i = suffix > memory ? suffix : memory;
+            while (i < m && needle[i] == hay[i + j]) { i++; }
+            if (i >= m) {
+                i = suffix - 1;
+                while (memory < i + 1 && needle[i] == hay[i + j]) { i--; }
+                if (i + 1 < memory + 1) { return j; }
+                j += period;
+                memory = m - period;
+            }
+            else {
+                j += i - suffix + 1;
+                memory = 0;
+            }
+        }
+    }
+    else {
+        period = (suffix > m - suffix ? suffix : m - suffix) + 1;
+        while (j + m <= n) {
+            size_t i = suffix;
+            while (i < m && needle[i] == hay[i + j]) { i++; }
+            if (i >= m) {
+                i = suffix - 1;
+                while (i != NOT_FOUND && needle[i] == hay[i + j]) { i--; }
+                if (i == NOT_FOUND) { return j; }
+                j += period;
+            }
+            else { j += i - suffix + 1; }
+        }
+    }
+    return NOT_FOUND;
+}
+
+inline size_t two_way_forward(const char* hay, const size_t n, const char* needle, const size_t m) {
+    return two_way(Forward{reinterpret_cast<const unsigned char*>(hay)}, n,
+                   Forward{reinterpret_cast<const unsigned char*>(needle)}, m);
+}
+
+#if MY_SIMD_X86
+// 首尾字节同时匹配的位置才做完整比较；验证代价超出预算说明输入对过滤不友好，剩余部分交给 Two-Way
+__attribute__((target("sse2"))) inline size_t filter_sse2(const char* hay, const size_t n, const char* needle,
+                                                          const size_t m) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[m - 1]);
+    size_t budget = VERIFY_SLACK;
+    size_t i = 0;
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+        const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + m - 1));
+        uint32_t mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last))));
+        while (mask != 0) {
+            const size_t at = i + __builtin_ctz(mask);
+            if (memcmp(hay + at + 1, needle + 1, m - 2) == 0) { return at; }
+            mask &= mask - 1;
+            if (budget < m) { break; }
+            budget -= m;
+        }
+        if (budget < m) { break; }
+        budget += 16 * VERIFY_FACTOR;
+    }
+    const size_t rest = two_way_forward(hay + i, n - i, needle, m);
+    return rest == NOT_FOUND ? NOT_FOUND : i + rest;
+}
+
+__attribute__((target("avx2"))) inline size_t filter_avx2(const char* hay, const size_t n, const char* needle,
+                                                          const size_t m) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+    size_t budget = VERIFY_SLACK;
+    size_t i = 0;
+    for (; i + m - 1 + 32 <= n; i += 32) {
+        const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i));
+        const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i + m - 1));
+        uint32_t mask = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last))));
+        while (mask != 0) {
+            const size_t at = i + __builtin_ctz(mask);
+            if (memcmp(hay + at + 1, needle + 1, m - 2) == 0) { return at; }
+            mask &= mask - 1;
+            if (budget < m) { break; }
+            budget -= m;
+        }
+        if (budget < m) { break; }
+        budget += 32 * VERIFY_FACTOR;
+    }
+    const size_t rest = two_way_forward(hay + i, n - i, needle, m);
+    return rest == NOT_FOUND ? NOT_FOUND : i + rest;
+}
+#endif
+
+// 子串首次出现的位置，空模式串匹配位置 0
+inline size_t find(const char* hay, const size_t n, const char* needle, const size_t m) {
+    if (m == 0) { return 0; }
+    if (m > n) { return NOT_FOUND; }
+    if (m == 1) { return find_byte(hay, n, needle[0]); }
+#if MY_SIMD_X86
+    switch (my_simd::isa()) {
+        case my_simd::Isa::AVX512:
+        case my_simd::Isa::AVX2: return filter_avx2(hay, n, needle, m);
+        case my_simd::Isa::SSE2: return filter_sse2(hay, n, needle, m);
+        default: break;
+    }
+#endif
+    return two_way_forward(hay, n, needle, m);
+}
+
+// 子串最后一次出现的位置，空模式串匹配位置 n
+inline size_t rfind(const char* hay, const size_t n, const char* needle, const size_t m) {
+    if (m == 0) { return n; }
+    if (m > n) { return NOT_FOUND; }
+    if (m == 1) { return rfind_byte(hay, n, needle[0]); }
+    const size_t found = two_way(Backward{reinterpret_cast<const unsigned char*>(hay + n)}, n,
+                                 Backward{reinterpret_cast<const unsigned char*>(needle + m)}, m);
+    return found == NOT_FOUND ? NOT_FOUND : n - found - m;
+}
+
+}  // namespace string_search
@@ -0,0 +1,86 @@
+// MyString 查找操作的测试：find、rfind、find_first_of、find_first_not_of 的结果与 std::string 对照。
+// 只含 1 到 3 种字母的随机串让部分匹配频繁出现，长的周期性模式串覆盖 Two-Way 的回退路径。
+// 用法：StringSearchTest [随机轮数]，默认 20000
+#include <cstdio>
+#include <string>
+#include "Bench.h"
+#include "MyString.h"
+
+static constexpr const char* SETS[] = {"", "a", "b", "ab", "ba", "abc", "xyz", "cx", "abcdefghij", "bcdefghijklmnop"};
+
+std::string random_string(bench::Random& random, const size_t length, const size_t letters) {
+    std::string result(length, 'a');
+    for (char& ch : result) { ch = static_cast<char>('a' + random.below(letters)); }
+    return result;
+}
+
+// 起点取 0、size、size + 1 和若干随机位置，每个起点都与 std::string 比较
+void check(const std::string& haystack, const std::string& needle, bench::Random& random) {
+    const MyString text(haystack.c_str());
+    const MyString pattern(needle.c_str());
+    const size_t size = haystack.size();
+    const size_t positions[] = {0, size, size + 1, random.below(size + 2), random.below(size + 2), std::string::npos};
+    for (const size_t pos : positions) {
+        BENCH_CHECK(text.find(pattern, pos) == haystack.find(needle, pos));
+        BENCH_CHECK(text.rfind(pattern, pos) == haystack.rfind(needle, pos));
+        if (!needle.empty()) {
+            BENCH_CHECK(text.find(needle[0], pos) == haystack.find(needle[0], pos));
+            BENCH_CHECK(text.rfind(needle[0], pos) == haystack.rfind(needle[0], pos));
+        }
+        for (const char* set : SETS) {
+            BENCH_CHECK(text.find_first_of(set, pos) == haystack.find_first_of(set, pos));
+            BENCH_CHECK(text.find_first_not_of(set, pos) == haystack.find_first_not_of(set, pos));
+        }
+    }
+    BENCH_CHECK(text.find(pattern) == haystack.find(needle));
+    BENCH_CHECK(text.rfind(pattern) == haystack.rfind(needle));
+    BENCH_CHECK(text.contains(pattern) == (haystack.find(needle) != std::string::npos));
+}
+
+// 随机串与随机或截取自串本身的模式串，长度跨过 SIMD 寄存器宽度
+void test_small_alphabets(const size_t rounds) {
+    bench::Random random;
+    for (size_t round = 0; round < rounds; round++) {
+        const size_t letters = 1 + random.below(3);
+        const std::string haystack = random_string(random, random.below(round % 16 == 0 ? 2000 : 160), letters);
+        std::string needle;
+        if (random.below(2) == 0 && !haystack.empty()) {
+            const size_t from = random.below(haystack.size());
+            needle = haystack.substr(from, random.below(24));
+        }
+        else { needle = random_string(random, random.below(12), letters); }
+        check(haystack, needle, random);
+    }
+}
+
+// 周期性的长模式串，只在末尾或中间某处打破周期，候选位置几乎都能通过首尾字节的过滤
+void test_periodic_needles() {
+    bench::Random random;
+    for (const char* unit : {"a", "ab", "aab", "abcabd"}) {
+        const std::string period(unit);
+        for (const size_t length : {64, 300, 1024, 4096}) {
+            std::string text;
+            while (text.size() < 40000) { text += period; }
+            std::string needle;
+            while (needle.size() < length) { needle += period; }
+            check(text, needle, random);
+            std::string broken = needle;
+            broken.back() = broken.back() == 'a' ? 'b' : 'a';
+            check(text, broken, random);
+            broken = needle;
+            broken[broken.size() / 2] = 'z';
+            check(text, broken, random);
+            // 在串中间埋一处真正的匹配
+            std::string planted = text;
+            planted.replace(planted.size() / 3, broken.size(), broken);
+            check(planted, broken, random);
+        }
+    }
+}
+
+int main(const int argc, char** argv) {
+    test_small_alphabets(bench::arg(argc, argv, 1, 20000));
+    test_periodic_needles();
+    std::puts("ok");
+    return 0;
+}
@@ -0,0 +1,347 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include "MySimd.h"
+#include "MyVector.h"
+#include "SurfVector.h"
+
+// SurfVectorBatch 的批量计算核心。每个核心只写一次，按寄存器宽度实例化为 SSE2 / AVX2 / AVX-512 三个版本，
+// 运行时选用 CPU 支持的最宽版本。寄存器类型来自 GCC / Clang 的向量扩展，其他编译器退化为逐元素计算
+namespace surf_simd {
+
+#if defined(__GNUC__)
+#define SURF_SIMD_INLINE [[gnu::always_inline]] inline
+#else
+#define SURF_SIMD_INLINE inline
+#endif
+
+// 一个寄存器容纳 W 个 T，ScalarLanes 是宽度为 1 的退化情形
+template<class T>
+struct ScalarLanes {
+    using Reg = T;
+    static constexpr int W = 1;
+    static T lane(const Reg& reg, int) { return reg; }
+};
+
+#if defined(__GNUC__)
+template<class T, int BYTES>
+struct VectorLanes {
+    using Reg [[gnu::vector_size(BYTES)]] = T;
+    static constexpr int W = BYTES / sizeof(T);
+    SURF_SIMD_INLINE static T lane(const Reg& reg, const int index) { return reg[index]; }
+};
+#endif
+
+// 寄存器按引用传递，避免不同指令集之间的调用约定差异
+template<class Reg, class T>
+SURF_SIMD_INLINE void load(Reg& reg, const T* source) { memcpy(&reg, source, sizeof(Reg)); }
+template<class Reg, class T>
+SURF_SIMD_INLINE void store(T* dest, const Reg& reg) { memcpy(dest, &reg, sizeof(Reg)); }
+
+// a[i] += b[i]
+struct Add {
+    template<class L, class T>
+    SURF_SIMD_INLINE static void run(T* a, const T* b, const size_t n) {
+        typename L::Reg ra, rb;
+        size_t i = 0;
+        for (; i + L::W <= n; i += L::W) {
+            load(ra, a + i);
+            load(rb, b + i);
+            ra += rb;
+            store(a + i, ra);
+        }
+        for (; i < n; i++) { a[i] += b[i]; }
+    }
+};
+
+// a[i] -= b[i]
+struct Sub {
+    template<class L, class T>
+    SURF_SIMD_INLINE static void run(T* a, const T* b, const size_t n) {
+        typename L::Reg ra, rb;
+        size_t i = 0;
+        for (; i + L::W <= n; i += L::W) {
+            load(ra, a + i);
+            load(rb, b + i);
+            ra -= rb;
+            store(a + i, ra);
+        }
+        for (; i < n; i++) { a[i] -= b[i]; }
+    }
+};
+
+// a[i] += value
+struct Offset {
+    template<class L, class T>
+    SURF_SIMD_INLINE static void run(T* a, const T value, const size_t n) {
+        typename L::Reg ra;
+        const typename L::Reg rv = typename L::Reg{} + value;
+        size_t i = 0;
+        for (; i + L::W <= n; i += L::W) {
+            load(ra, a + i);
+            ra += rv;
+            store(a + i, ra);
+        }
+        for (; i < n; i++) { a[i] += value; }
+    }
+};
+
+// a[i] *= value
+struct Scale {
+    template<class L, class T>
+    SURF_SIMD_INLINE static void run(T* a, const T value, const size_t n) {
+        typename L::Reg ra;
+        const typename L::Reg rv = typename L::Reg{} + value;
+        size_t i = 0;
+        for (; i + L::W <= n; i += L::W) {
+            load(ra, a + i);
+            ra *= rv;
+            store(a + i, ra);
+        }
+        for (; i < n; i++) { a[i] *= value; }
+    }
+};
+
+// out[i] = x[i] * vx + y[i] * vy
+struct Dot {
+    template<class L, class T>
+    SURF_SIMD_INLINE static void run(const T* x, const T* y, const T vx, const T vy, T* out, const size_t n) {
+        typename L::Reg rx, ry;
+        const typename L::Reg rvx = typename L::Reg{} + vx;
+        const typename L::Reg rvy = typename L::Reg{} + vy;
+        size_t i = 0;
+        for (; i + L::W <= n; i += L::W) {
+            load(rx, x + i);
+            load(ry, y + i);
+            rx = rx * rvx + ry * rvy;
+            store(out + i, rx);
+        }
+        for (; i < n; i++) { out[i] = x[i] * vx + y[i] * vy; }
+    }
+};
+
+// out[i] = x[i] * ox[i] + y[i] * oy[i]
+struct DotPairwise {
+    template<class L, class T>
+    SURF_SIMD_INLINE static void run(const T* x, const T* y, const T* ox, const T* oy, T* out, const size_t n) {
+        typename L::Reg rx, ry, rox, roy;
+        size_t i = 0;
+        for (; i + L::W <= n; i += L::W) {
+            load(rx, x + i);
+            load(ry, y + i);
+            load(rox, ox + i);
+            load(roy, oy + i);
+            rx = rx * rox + ry * roy;
+            store(out + i, rx);
+        }
+        for (; i < n; i++) { out[i] = x[i] * ox[i] + y[i] * oy[i]; }
+    }
+};
+
+// out[i] = |(x[i], y[i])|
+struct Norm {
+    template<class L, class T>
+    SURF_SIMD_INLINE static void run(const T* x, const T* y, T* out, const size_t n) {
+        typename L::Reg rx, ry;
+        size_t i = 0;
+        for (; i + L::W <= n; i += L::W) {
+            load(rx, x + i);
+            load(ry, y + i);
+            rx = rx * rx + ry * ry;
+            for (int k = 0; k < L::W; k++) { out[i + k] = static_cast<T>(std::sqrt(L::lane(rx, k))); }
+        }
+        for (; i < n; i++) { out[i] = static_cast<T>(std::sqrt(x[i] * x[i] + y[i] * y[i])); }
+    }
+};
+
+// a[0] + ... + a[n - 1]，每条通道各自累加，最后再合并
+struct Sum {
+    template<class L, class T>
+    SURF_SIMD_INLINE static T run(const T* a, const size_t n) {
+        typename L::Reg acc{}, ra;
+        size_t i = 0;
+        for (; i + L::W <= n; i += L::W) {
+            load(ra, a + i);
+            acc += ra;
+        }
+        T result{};
+        for (int k = 0; k < L::W; k++) { result += L::lane(acc, k); }
+        for (; i < n; i++) { result += a[i]; }
+        return result;
+    }
+};
+
+// max(x[i]^2 + y[i]^2)，n 为 0 时返回 0
+struct MaxNormSquared {
+    template<class L, class T>
+    SURF_SIMD_INLINE static T run(const T* x, const T* y, const size_t n) {
+        typename L::Reg acc{}, rx, ry;
+        size_t i = 0;
+        for (; i + L::W <= n; i += L::W) {
+            load(rx, x + i);
+            load(ry, y + i);
+            rx = rx * rx + ry * ry;
+            acc = rx > acc ? rx : acc;
+        }
+        T result{};
+        for (int k = 0; k < L::W; k++) {
+            if (L::lane(acc, k) > result) { result = L::lane(acc, k); }
+        }
+        for (; i < n; i++) {
+            const T value = x[i] * x[i] + y[i] * y[i];
+            if (value > result) { result = value; }
+        }
+        return result;
+    }
+};
+
+#if MY_SIMD_X86
+template<class K, class T, class... Args>
+__attribute__((target("avx512f"))) auto run_avx512(Args... args) {
+    return K::template run<VectorLanes<T, 64>>(args...);
+}
+template<class K, class T, class... Args>
+__attribute__((target("avx2"))) auto run_avx2(Args... args) {
+    return K::template run<VectorLanes<T, 32>>(args...);
+}
+template<class K, class T, class... Args>
+__attribute__((target("sse2"))) auto run_sse2(Args... args) {
+    return K::template run<VectorLanes<T, 16>>(args...);
+}
+#endif
+
+// 按指令集分派核心 K，只有 float / double 走向量版本
+template<class K, class T, class... Args>
+auto run(Args... args) {
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+#if MY_SIMD_X86
+        switch (my_simd::isa()) {
+            case my_simd::Isa::AVX512: return run_avx512<K, T>(args...);
+            case my_simd::Isa::AVX2: return run_avx2<K, T>(args...);
+            case my_simd::Isa::SSE2: return run_sse2<K, T>(args...);
+            default: break;
+        }
+#elif defined(__GNUC__)
+        return K::template run<VectorLanes<T, 16>>(args...);
+#endif
+    }
+    return K::template run<ScalarLanes<T>>(args...);
+}
+
+}  // namespace surf_simd
+
+// SurfVector 的结构数组（SoA）形式：所有 x 与所有 y 分别连续存放，批量运算整段交给向量化的核心。
+// 单个元素以 SurfVector 的形式读写
+template<class T, class Alloc = MyAllocator<T>>
+class SurfVectorBatch {
+private:
+    MyVector<T, Alloc> xs;
+    MyVector<T, Alloc> ys;
+
+    void check_size(const SurfVectorBatch& other) const {
+        if (size() != other.size()) { throw std::runtime_error("batch size mismatch"); }
+    }
+
+public:
+    SurfVectorBatch() = default;
+    explicit SurfVectorBatch(const Alloc& alloc) : xs(alloc), ys(alloc) {}
+    explicit SurfVectorBatch(const size_t num, const SurfVector<T>& value = SurfVector<T>(T(), T()),
+                             const Alloc& alloc = Alloc())
+        : xs(num, value.x(), alloc), ys(num, value.y(), alloc) {}
+
+    [[nodiscard]] size_t size() const { return xs.size(); }
+    [[nodiscard]] bool empty() const { return xs.empty(); }
+    void reserve(const size_t add_capacity) {
+        xs.reserve(add_capacity);
+        ys.reserve(add_capacity);
+    }
+    void clear() {
+        xs.clear();
+        ys.clear();
+    }
+    void resize(const size_t num, const SurfVector<T>& value = SurfVector<T>(T(), T())) {
+        xs.resize(num, value.x());
+        ys.resize(num, value.y());
+    }
+
+    SurfVectorBatch& push_back(const SurfVector<T>& value) {
+        xs.push_back(value.x());
+        ys.push_back(value.y());
+        return *this;
+    }
+    void pop_back() {
+        xs.pop_back();
+        ys.pop_back();
+    }
+
+    SurfVector<T> operator[](const size_t index) const { return SurfVector<T>(xs[index], ys[index]); }
+    void set(const size_t index, const SurfVector<T>& value) {
+        xs[index] = value.x();
+        ys[index] = value.y();
+    }
+
+    T* x_data() const { return xs.data(); }
+    T* y_data() const { return ys.data(); }
+
+    // 逐元素相加 / 相减，两批大小必须相同
+    SurfVectorBatch& operator+=(const SurfVectorBatch& other) {
+        check_size(other);
+        surf_simd::run<surf_simd::Add, T>(xs.data(), other.xs.data(), size());
+        surf_simd::run<surf_simd::Add, T>(ys.data(), other.ys.data(), size());
+        return *this;
+    }
+    SurfVectorBatch& operator-=(const SurfVectorBatch& other) {
+        check_size(other);
+        surf_simd::run<surf_simd::Sub, T>(xs.data(), other.xs.data(), size());
+        surf_simd::run<surf_simd::Sub, T>(ys.data(), other.ys.data(), size());
+        return *this;
+    }
+    // 整体平移
+    SurfVectorBatch& operator+=(const SurfVector<T>& offset) {
+        surf_simd::run<surf_simd::Offset, T>(xs.data(), offset.x(), size());
+        surf_simd::run<surf_simd::Offset, T>(ys.data(), offset.y(), size());
+        return *this;
+    }
+    SurfVectorBatch& operator-=(const SurfVector<T>& offset) { return *this += offset * T(-1); }
+    SurfVectorBatch& operator*=(const T scalar) {
+        surf_simd::run<surf_simd::Scale, T>(xs.data(), scalar, size());
+        surf_simd::run<surf_simd::Scale, T>(ys.data(), scalar, size());
+        return *this;
+    }
+
+    // 每个元素与 other 的点积
+    MyVector<T, Alloc> dot(const SurfVector<T>& other) const {
+        MyVector<T, Alloc> result(size(), T(), xs.get_allocator());
+        surf_simd::run<surf_simd::Dot, T>(xs.data(), ys.data(), other.x(), other.y(), result.data(), size());
+        return result;
+    }
+    // 两批对应元素的点积
+    MyVector<T, Alloc> dot(const SurfVectorBatch& other) const {
+        check_size(other);
+        MyVector<T, Alloc> result(size(), T(), xs.get_allocator());
+        surf_simd::run<surf_simd::DotPairwise, T>(xs.data(), ys.data(), other.xs.data(), other.ys.data(),
+                                                  result.data(), size());
+        return result;
+    }
+    // 每个元素的长度
+    MyVector<T, Alloc> norms() const {
+        MyVector<T, Alloc> result(size(), T(), xs.get_allocator());
+        surf_simd::run<surf_simd::Norm, T>(xs.data(), ys.data(), result.data(), size());
+        return result;
+    }
+
+    // 所有元素之和
+    SurfVector<T> sum() const {
+        return SurfVector<T>(surf_simd::run<surf_simd::Sum, T>(xs.data(), size()),
+                             surf_simd::run<surf_simd::Sum, T>(ys.data(), size()));
+    }
+    // 最长元素的长度，空批返回 0
+    T max_norm() const {
+        return static_cast<T>(std::sqrt(surf_simd::run<surf_simd::MaxNormSquared, T>(xs.data(), ys.data(), size())));
+    }
+
+    Alloc get_allocator() const { return xs.get_allocator(); }
+};
@@ -0,0 +1,251 @@
+#pragma once
+#include <cstddef>
+#include <concepts>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// MyVector 与 MySmallVector 共用的元素搬移与区间操作（CRTP）。两者的存储方式不同，
+// 派生类提供成员 alloc、size_、capacity_、ptr 和 REMAPPABLE，以及 grow_capacity、adopt、reallocate，
+// 并把本类声明为友元
+namespace vector_detail {
+
+template<class Derived, class T, class Alloc>
+class VectorOps {
+private:
+    using Traits = std::allocator_traits<Alloc>;
+
+    Derived& self() { return static_cast<Derived&>(*this); }
+    const Derived& self() const { return static_cast<const Derived&>(*this); }
+
+protected:
+    // 把 source 中的 num 个元素移动构造到未初始化的 dest，移动可能抛异常时改为复制，原元素保持存活
+    void move_to(T* dest, T* source, const size_t num) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (num > 0) { memcpy(dest, source, num * sizeof(T)); }
+        }
+        else {
+            size_t i = 0;
+            try {
+                for (; i < num; i++) { Traits::construct(self().alloc, dest + i, std::move_if_noexcept(source[i])); }
+            }
+            catch (...) {
+                while (i > 0) { Traits::destroy(self().alloc, dest + --i); }
+                throw;
+            }
+        }
+    }
+
+    // 把 source 中的 num 个元素搬到未初始化的 dest 并析构原元素：
+    // 平凡类型整块 memcpy，其余类型在移动不抛异常时移动，否则复制
+    void relocate(T* dest, T* source, const size_t num) {
+        move_to(dest, source, num);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < num; i++) { Traits::destroy(self().alloc, source + i); }
+        }
+    }
+
+    // 区间长度，迭代器只需支持 ++ 和 !=
+    template<class InputIt>
+    static size_t distance(InputIt first, const InputIt last) {
+        size_t num = 0;
+        for (; first != last; ++first) { num++; }
+        return num;
+    }
+
+    // 把从 first 开始的 num 个元素复制构造到未初始化的 dest，同类型指针区间整块 memcpy
+    template<class InputIt>
+    void construct_range(T* dest, InputIt first, const size_t num) {
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_pointer_v<InputIt> &&
+                      std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>, T>) {
+            if (num > 0) { memcpy(dest, first, num * sizeof(T)); }
+        }
+        else {
+            size_t i = 0;
+            try {
+                for (; i < num; i++, ++first) { Traits::construct(self().alloc, dest + i, *first); }
+            }
+            catch (...) {
+                while (i > 0) { Traits::destroy(self().alloc, dest + --i); }
+                throw;
+            }
+        }
+    }
+
+    void fill_to(T* dest, const T& value, const size_t num) {
+        size_t i = 0;
+        try {
+            for (; i < num; i++) { Traits::construct(self().alloc, dest + i, value); }
+        }
+        catch (...) {
+            while (i > 0) { Traits::destroy(self().alloc, dest + --i); }
+            throw;
+        }
+    }
+
+    // 区间的第一个元素是否位于本容器的 [0, size_) 中。连续的区间不会跨出所在的缓冲区，只需检查第一个元素；
+    // 解引用得不到 T 的地址的迭代器不可能指向本容器
+    template<class InputIt>
+    bool aliases(const InputIt& first) const {
+        if constexpr (requires { { std::addressof(*first) } -> std::convertible_to<const T*>; }) {
+            const T* source = std::addressof(*first);
+            const Derived& v = self();
+            return std::less_equal<const T*>()(v.ptr, source) && std::less<const T*>()(source, v.ptr + v.size_);
+        }
+        else { return false; }
+    }
+
+    // 至少容纳 required 个元素，同时保持几何增长
+    size_t fit_capacity(const size_t required) const {
+        const Derived& v = self();
+        const size_t grown = v.grow_capacity(v.capacity_);
+        return required > grown ? required : grown;
+    }
+
+    // 容量不足时只重新分配一次：先在新缓冲区的 [pos, pos + num) 处构造新元素，
+    // 再把原有的前后两段搬过去，这样新元素的来源引用本容器时依然有效
+    template<class Build>
+    void grow_and_insert(const size_t pos, const size_t num, Build build) {
+        Derived& v = self();
+        if constexpr (Derived::REMAPPABLE) {
+            // 缓冲区可能被重映射到别处，调用方需保证新元素的来源不在本容器中
+            v.reallocate(fit_capacity(v.size_ + num));
+            memmove(v.ptr + pos + num, v.ptr + pos, (v.size_ - pos) * sizeof(T));
+            try { build(v.ptr + pos); }
+            catch (...) {
+                memmove(v.ptr + pos, v.ptr + pos + num, (v.size_ - pos) * sizeof(T));
+                throw;
+            }
+            v.size_ += num;
+            return;
+        }
+        const size_t new_capacity = fit_capacity(v.size_ + num);
+        T* new_ptr = Traits::allocate(v.alloc, new_capacity);
+        try { build(new_ptr + pos); }
+        catch (...) {
+            Traits::deallocate(v.alloc, new_ptr, new_capacity);
+            throw;
+        }
+        size_t moved = 0;
+        try {
+            move_to(new_ptr, v.ptr, pos);
+            moved = pos;
+            move_to(new_ptr + pos + num, v.ptr + pos, v.size_ - pos);
+        }
+        catch (...) {
+            for (size_t i = 0; i < moved; i++) { Traits::destroy(v.alloc, new_ptr + i); }
+            for (size_t i = 0; i < num; i++) { Traits::destroy(v.alloc, new_ptr + pos + i); }
+            Traits::deallocate(v.alloc, new_ptr, new_capacity);
+            throw;
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < v.size_; i++) { Traits::destroy(v.alloc, v.ptr + i); }
+        }
+        v.adopt(new_ptr, new_capacity);
+        v.size_ += num;
+    }
+
+public:
+    // 把 [first, last) 插入到 index 之前，至多一次重新分配、一次整体移动
+    template<class InputIt> requires (!std::is_integral_v<InputIt>)
+    void insert(const size_t index, InputIt first, InputIt last) {
+        Derived& v = self();
+        const size_t num = distance(first, last);
+        if (num == 0) return;
+        const size_t pos = index < v.size_ ? index : v.size_;
+        const bool grow = v.size_ + num > v.capacity_;
+        // 区间来自本容器时先复制出来：不扩容时移动尾部会改写还没读取的元素，
+        // 缓冲区可能被重映射时扩容后区间就失效了；普通的扩容先构造新元素，不受影响
+        if ((!grow || Derived::REMAPPABLE) && aliases(first)) {
+            const Derived copy(first, last, v.alloc);
+            insert(pos, copy.data(), copy.data() + num);
+            return;
+        }
+        if (grow) {
+            grow_and_insert(pos, num, [&](T* dest) { construct_range(dest, first, num); });
+            return;
+        }
+        T* ptr = v.ptr;
+        const size_t size = v.size_;
+        const size_t tail = size - pos;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            memmove(ptr + pos + num, ptr + pos, tail * sizeof(T));
+            construct_range(ptr + pos, first, num);
+        }
+        else if (tail > num) {
+            // 尾部最后 num 个元素移入未初始化区域，其余尾部元素向后移动赋值，再覆盖插入位置
+            move_to(ptr + size, ptr + size - num, num);
+            for (size_t i = size - num; i > pos; i--) { ptr[i - 1 + num] = std::move(ptr[i - 1]); }
+            for (size_t i = 0; i < num; i++, ++first) { ptr[pos + i] = *first; }
+        }
+        else {
+            // 区间超出尾部的部分直接构造在未初始化区域，尾部元素整体移到它们之后
+            InputIt mid = first;
+            for (size_t i = 0; i < tail; i++) { ++mid; }
+            construct_range(ptr + size, mid, num - tail);
+            try { move_to(ptr + pos + num, ptr + pos, tail); }
+            catch (...) {
+                for (size_t i = size; i < pos + num; i++) { Traits::destroy(v.alloc, ptr + i); }
+                throw;
+            }
+            for (size_t i = 0; i < tail; i++, ++first) { ptr[pos + i] = *first; }
+        }
+        v.size_ += num;
+    }
+    template<class InputIt> requires (!std::is_integral_v<InputIt>)
+    void append(InputIt first, InputIt last) { insert(self().size_, first, last); }
+
+    // 删除下标 [first, last) 的元素
+    void erase(const size_t first, size_t last) {
+        Derived& v = self();
+        if (last > v.size_) { last = v.size_; }
+        if (first >= last) return;
+        const size_t num = last - first;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            memmove(v.ptr + first, v.ptr + last, (v.size_ - last) * sizeof(T));
+        }
+        else {
+            for (size_t i = last; i < v.size_; i++) { v.ptr[i - num] = std::move(v.ptr[i]); }
+            for (size_t i = v.size_ - num; i < v.size_; i++) { Traits::destroy(v.alloc, v.ptr + i); }
+        }
+        v.size_ -= num;
+    }
+    void erase(const size_t index) { erase(index, index + 1); }
+
+    void resize(const size_t num, const T& value = T()) {
+        Derived& v = self();
+        if (num <= v.size_) {
+            erase(num, v.size_);
+            return;
+        }
+        if (num > v.capacity_) {
+            const T temp = value;  // value 可能引用本容器中的元素
+            grow_and_insert(v.size_, num - v.size_, [&](T* dest) { fill_to(dest, temp, num - v.size_); });
+            return;
+        }
+        fill_to(v.ptr + v.size_, value, num - v.size_);
+        v.size_ = num;
+    }
+
+    template<class InputIt> requires (!std::is_integral_v<InputIt>)
+    void assign(InputIt first, InputIt last) {
+        Derived& v = self();
+        const size_t num = distance(first, last);
+        v.clear();
+        if (num > v.capacity_) { v.adopt(Traits::allocate(v.alloc, num), num); }
+        construct_range(v.ptr, first, num);
+        v.size_ = num;
+    }
+    void assign(const size_t num, const T& value) {
+        Derived& v = self();
+        const T temp = value;  // value 可能引用本容器中的元素
+        v.clear();
+        if (num > v.capacity_) { v.adopt(Traits::allocate(v.alloc, num), num); }
+        fill_to(v.ptr, temp, num);
+        v.size_ = num;
+    }
+};
+
+}  // namespace vector_detail